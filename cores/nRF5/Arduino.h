@@ -48,6 +48,7 @@ void loop( void ) ;
 #ifdef __cplusplus
   #include "WCharacter.h"
   #include "WString.h"
+  #include "BufferPrint.h"
   // #include "Tone.h"
   #include "WMath.h"
   #include "HardwareSerial.h"
@@ -55,6 +56,9 @@ void loop( void ) ;
 #endif
 #include "delay.h"
 #include "binary.h"
+#include "mempool.h"
+#include "ram_usage.h"
+#include "ramfunc.h"
 #ifdef __cplusplus
   #include "Uart.h"
 #endif
@@ -0,0 +1,62 @@
+/*
+  BufferPrint.cpp - Print into a fixed character buffer
+  Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <string.h>
+
+#include "BufferPrint.h"
+
+BufferPrint::BufferPrint(char *buffer, size_t size) :
+  buffer(size ? buffer : NULL),
+  capacity(size ? size - 1 : 0)
+{
+  clear();
+}
+
+size_t BufferPrint::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t BufferPrint::write(const uint8_t *data, size_t size)
+{
+  if (size > capacity - len) {
+    size = capacity - len;
+    overflow = true;
+  }
+
+  if (size == 0) {
+    return 0;
+  }
+
+  memcpy(buffer + len, data, size);
+  len += size;
+  buffer[len] = '\0';
+
+  return size;
+}
+
+void BufferPrint::clear()
+{
+  len = 0;
+  overflow = false;
+
+  if (buffer) {
+    buffer[0] = '\0';
+  }
+}
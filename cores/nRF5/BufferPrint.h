@@ -0,0 +1,55 @@
+/*
+  BufferPrint.h - Print into a fixed character buffer
+  Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef BufferPrint_h
+#define BufferPrint_h
+
+#include "Print.h"
+#include "StringView.h"
+
+// Builds text with print(), println() and printf() in a buffer the sketch
+// owns, the allocation free alternative to String concatenation and
+// String::format(). The text is always '\0' terminated, whatever doesn't
+// fit is dropped and flagged with overflowed().
+class BufferPrint : public Print
+{
+  public:
+    BufferPrint(char *buffer, size_t size);
+
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+
+    virtual int availableForWrite() { return capacity - len; }
+
+    const char *c_str() const { return buffer ? buffer : ""; }
+    size_t length() const { return len; }
+    bool overflowed() const { return overflow; }
+    StringView view() const { return StringView(c_str(), len); }
+
+    void clear();
+
+  private:
+    char *buffer;
+    size_t capacity;  // characters that fit, the terminator excluded
+    size_t len;
+    bool overflow;
+};
+
+#endif
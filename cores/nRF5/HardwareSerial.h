@@ -73,6 +73,7 @@ class HardwareSerial : public Stream
     virtual int available(void) = 0;
     virtual int peek(void) = 0;
     virtual int read(void) = 0;
+    using Stream::read; // pull in the bulk read(buffer, length) from Stream
     virtual void flush(void) = 0;
     virtual size_t write(uint8_t) = 0;
     using Print::write; // pull in write(str) and write(buf, size) from Print
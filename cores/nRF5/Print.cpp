@@ -23,6 +23,7 @@
 #include "Arduino.h"
 
 #include "Print.h"
+#include "avr/dtostrf.h"
 
 // Public Methods //////////////////////////////////////////////////////////////
 
@@ -47,6 +48,11 @@ size_t Print::print(const String &s)
   return write(s.c_str(), s.length());
 }
 
+size_t Print::print(StringView view)
+{
+  return write(view.data(), view.length());
+}
+
 size_t Print::print(const char str[])
 {
   return write(str);
@@ -123,6 +129,13 @@ size_t Print::println(const String &s)
   return n;
 }
 
+size_t Print::println(StringView view)
+{
+  size_t n = print(view);
+  n += println();
+  return n;
+}
+
 size_t Print::println(const char c[])
 {
   size_t n = print(c);
@@ -186,68 +199,345 @@ size_t Print::println(const Printable& x)
   return n;
 }
 
-// Private Methods /////////////////////////////////////////////////////////////
+// Output buffer of printf(), handed to write() whenever it fills up
+class PrintfBuffer
+{
+  public:
+    PrintfBuffer(Print &p) : out(p), length(0), count(0) {}
 
-size_t Print::printNumber(unsigned long n, uint8_t base)
+    void put(char c)
+    {
+      if (length == sizeof(buffer)) flush();
+      buffer[length++] = c;
+    }
+
+    void put(const char *str, size_t size)
+    {
+      while (size--) put(*str++);
+    }
+
+    void fill(char c, int times)
+    {
+      while (times-- > 0) put(c);
+    }
+
+    size_t flush()
+    {
+      if (length) {
+        count += out.write(buffer, length);
+        length = 0;
+      }
+      return count;
+    }
+
+  private:
+    Print &out;
+    char buffer[32];
+    size_t length;
+    size_t count;
+};
+
+// One converted field of printf(): the sign or base prefix, zeros up to the
+// precision and the characters, padded to width
+static void putField(PrintfBuffer &out, const char *prefix, int zeros, const char *body, const char *end, int width, bool left, bool zero)
 {
-  char buf[8 * sizeof(long) + 1]; // Assumes 8-bit chars plus zero byte.
-  char *str = &buf[sizeof(buf) - 1];
+  int length = strlen(prefix) + (zeros > 0 ? zeros : 0) + (end - body);
+  int padding = width - length;
+
+  if (!left && !zero) out.fill(' ', padding);
+  out.put(prefix, strlen(prefix));
+  if (!left && zero) out.fill('0', padding);
+  out.fill('0', zeros);
+  out.put(body, end - body);
+  if (left) out.fill(' ', padding);
+}
 
-  *str = '\0';
+// %f of values at or beyond FMTDOUBLE_LARGE, all their integer digits. Kept
+// out of vprintf() so only these pay for the buffer that holds them.
+static void __attribute__ ((noinline)) putLargeDouble(PrintfBuffer &out, double value, int precision, char sign, int width, bool left, bool zero)
+{
+  char tmp[FMTDOUBLE_LARGE_BUFFER_SIZE(FMTDOUBLE_MAX_PREC)];
+  size_t length = fmtdouble(value, precision, tmp);
+  const char *prefix = "";
+  const char *body = tmp;
+
+  if (*body == '-') {
+    prefix = "-";
+    body++;
+  } else if (sign == '+') {
+    prefix = "+";
+  } else if (sign == ' ') {
+    prefix = " ";
+  }
 
-  // prevent crash if called with base == 1
-  if (base < 2) base = 10;
+  putField(out, prefix, 0, body, tmp + length, width, left, zero);
+}
 
-  do {
-    char c = n % base;
-    n /= base;
+size_t Print::printf(const char *format, ...)
+{
+  va_list args;
 
-    *--str = c < 10 ? c + '0' : c + 'A' - 10;
-  } while(n);
+  va_start(args, format);
+  size_t n = vprintf(format, args);
+  va_end(args);
 
-  return write(str);
+  return n;
 }
 
-size_t Print::printFloat(double number, uint8_t digits)
+size_t Print::vprintf(const char *format, va_list args)
 {
-  size_t n = 0;
+  PrintfBuffer out(*this);
+  // digits of any conversion, the longest is %f with all decimals
+  char tmp[FMTDOUBLE_BUFFER_SIZE(FMTDOUBLE_MAX_PREC)];
+  char * const digits = &tmp[sizeof(tmp)];
+
+  while (*format) {
+    if (*format != '%') {
+      out.put(*format++);
+      continue;
+    }
+
+    format++;
+
+    bool left = false, zero = false, alternate = false;
+    char sign = 0;
 
-  if (isnan(number)) return print("nan");
-  if (isinf(number)) return print("inf");
-  if (number > 4294967040.0) return print ("ovf");  // constant determined empirically
-  if (number <-4294967040.0) return print ("ovf");  // constant determined empirically
+    for (;; format++) {
+      if (*format == '-') left = true;
+      else if (*format == '0') zero = true;
+      else if (*format == '+') sign = '+';
+      else if (*format == ' ') { if (!sign) sign = ' '; }
+      else if (*format == '#') alternate = true;
+      else break;
+    }
+
+    int width = 0;
+
+    if (*format == '*') {
+      width = va_arg(args, int);
+      if (width < 0) {
+        left = true;
+        width = -width;
+      }
+      format++;
+    } else {
+      while (isdigit(*format)) width = width * 10 + (*format++ - '0');
+    }
+
+    int precision = -1;
+
+    if (*format == '.') {
+      format++;
+      precision = 0;
 
-  // Handle negative numbers
-  if (number < 0.0)
-  {
-     n += print('-');
-     number = -number;
+      if (*format == '*') {
+        precision = va_arg(args, int);
+        format++;
+      } else {
+        while (isdigit(*format)) precision = precision * 10 + (*format++ - '0');
+      }
+    }
+
+    int size = 0; // -2 hh, -1 h, 1 l, 2 ll
+
+    for (;; format++) {
+      if (*format == 'h') size--;
+      else if (*format == 'l') size++;
+      else if (*format == 'z' || *format == 'j' || *format == 't') size = (*format == 'j') ? 2 : 0;
+      else break;
+    }
+
+    char conversion = *format;
+
+    if (conversion == '\0') {
+      break;
+    }
+
+    format++;
+
+    const char *body = digits;
+    const char *end = digits;
+    const char *prefix = "";
+    int zeros = 0;
+
+    switch (conversion) {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o':
+      case 'p': {
+        unsigned long long value;
+        bool negative = false;
+        int radix = 10;
+
+        if (conversion == 'd' || conversion == 'i') {
+          long long v;
+
+          if (size >= 2) v = va_arg(args, long long);
+          else if (size == 1) v = va_arg(args, long);
+          else v = va_arg(args, int);
+
+          if (size == -1) v = (short)v;
+          else if (size <= -2) v = (signed char)v;
+
+          negative = v < 0;
+          value = negative ? -(unsigned long long)v : v;
+        } else {
+          if (conversion == 'p') value = (uintptr_t)va_arg(args, void *);
+          else if (size >= 2) value = va_arg(args, unsigned long long);
+          else if (size == 1) value = va_arg(args, unsigned long);
+          else value = va_arg(args, unsigned int);
+
+          if (size == -1) value = (unsigned short)value;
+          else if (size <= -2) value = (unsigned char)value;
+
+          if (conversion == 'o') radix = 8;
+          else if (conversion != 'u') radix = 16;
+
+          sign = 0;
+        }
+
+        // a zero value with zero precision prints no digits
+        if (value || precision != 0) {
+          body = (value > 0xFFFFFFFFULL) ? ulltostr(value, digits, radix, conversion == 'X') : ultostr(value, digits, radix, conversion == 'X');
+        }
+
+        if (negative) prefix = "-";
+        else if (sign == '+') prefix = "+";
+        else if (sign == ' ') prefix = " ";
+        else if (conversion == 'p' || (alternate && value && radix == 16)) prefix = (conversion == 'X') ? "0X" : "0x";
+        else if (alternate && radix == 8 && value) prefix = "0";
+
+        if (precision >= 0) {
+          zeros = precision - (end - body);
+          zero = false;
+        }
+        break;
+      }
+
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G': {
+        double value = va_arg(args, double);
+
+        size_t length;
+
+        if (precision < 0) precision = 6;
+
+        if (conversion == 'e' || conversion == 'E') {
+          length = fmtexponent(value, precision, conversion == 'E', tmp);
+        } else if (conversion == 'g' || conversion == 'G') {
+          length = fmtgeneral(value, precision, conversion == 'G', alternate, tmp);
+        } else if (fabs(value) >= FMTDOUBLE_LARGE && !isinf(value)) {
+          putLargeDouble(out, value, precision, sign, width, left, zero);
+          continue;
+        } else {
+          length = fmtdouble(value, precision, tmp);
+        }
+
+        body = tmp;
+        end = tmp + length;
+
+        if (*body == '-') {
+          prefix = "-";
+          body++;
+        } else if (sign == '+') {
+          prefix = "+";
+        } else if (sign == ' ') {
+          prefix = " ";
+        }
+
+        // nan and inf aren't padded with zeros
+        if (!isdigit(*body)) zero = false;
+        break;
+      }
+
+      case 'c':
+        tmp[0] = (char)va_arg(args, int);
+        body = tmp;
+        end = tmp + 1;
+        zero = false;
+        break;
+
+      case 's': {
+        const char *str = va_arg(args, const char *);
+
+        if (str == NULL) str = "(null)";
+
+        size_t length = 0;
+
+        while (str[length] && (precision < 0 || length < (size_t)precision)) length++;
+
+        body = str;
+        end = str + length;
+        zero = false;
+        break;
+      }
+
+      case '%':
+        out.put('%');
+        continue;
+
+      default:
+        // not supported, printed as is
+        out.put('%');
+        out.put(conversion);
+        continue;
+    }
+
+    putField(out, prefix, zeros, body, end, width, left, zero);
   }
 
-  // Round correctly so that print(1.999, 2) prints as "2.00"
-  double rounding = 0.5;
-  for (uint8_t i=0; i<digits; ++i)
-    rounding /= 10.0;
+  return out.flush();
+}
+
+// Private Methods /////////////////////////////////////////////////////////////
 
-  number += rounding;
+size_t Print::printNumber(unsigned long n, uint8_t base)
+{
+  char buf[8 * sizeof(long)]; // Assumes 8-bit chars.
+  char *end = &buf[sizeof(buf)];
 
-  // Extract the integer part of the number and print it
-  unsigned long int_part = (unsigned long)number;
-  double remainder = number - (double)int_part;
-  n += print(int_part);
+  // prevent crash if called with base == 1
+  if (base < 2) base = 10;
 
-  // Print the decimal point, but only if there are digits beyond
-  if (digits > 0) {
-    n += print(".");
+  char *str = ultostr(n, end, base, 1);
+
+  return write(str, end - str);
+}
+
+// the integer digits of the values beyond 2^64, with a buffer for all of
+// them that only takes stack when it's needed
+static size_t __attribute__ ((noinline)) printLargeDouble(Print &out, double number, uint8_t digits)
+{
+  char buf[FMTDOUBLE_LARGE_BUFFER_SIZE(FMTDOUBLE_MAX_PREC)];
+  size_t length = fmtdouble(number, digits, buf);
+
+  return out.write(buf, length);
+}
+
+size_t Print::printFloat(double number, uint8_t digits)
+{
+  size_t n;
+
+  if (fabs(number) >= FMTDOUBLE_LARGE && !isinf(number)) {
+    n = printLargeDouble(*this, number, digits);
+  } else {
+    char buf[FMTDOUBLE_BUFFER_SIZE(FMTDOUBLE_MAX_PREC)];
+    size_t length = fmtdouble(number, digits, buf);
+    n = write(buf, length);
   }
 
-  // Extract digits from the remainder one at a time
-  while (digits-- > 0)
-  {
-    remainder *= 10.0;
-    int toPrint = int(remainder);
-    n += print(toPrint);
-    remainder -= toPrint;
+  // decimals beyond the resolution of a double, unless nan/inf
+  if (digits > FMTDOUBLE_MAX_PREC && isfinite(number)) {
+    for (digits -= FMTDOUBLE_MAX_PREC; digits > 0; digits--) {
+      n += print('0');
+    }
   }
 
   return n;
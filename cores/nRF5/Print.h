@@ -20,6 +20,7 @@
 #define Print_h
 
 #include <inttypes.h>
+#include <stdarg.h>
 #include <stdio.h> // for size_t
 
 #include "WString.h"
@@ -54,8 +55,12 @@ class Print
       return write((const uint8_t *)buffer, size);
     }
 
+    // bytes write() takes without blocking, 0 if not known
+    virtual int availableForWrite() { return 0; }
+
     size_t print(const __FlashStringHelper *);
     size_t print(const String &);
+    size_t print(StringView);
     size_t print(const char[]);
     size_t print(char);
     size_t print(unsigned char, int = DEC);
@@ -68,6 +73,7 @@ class Print
 
     size_t println(const __FlashStringHelper *);
     size_t println(const String &s);
+    size_t println(StringView);
     size_t println(const char[]);
     size_t println(char);
     size_t println(unsigned char, int = DEC);
@@ -78,6 +84,14 @@ class Print
     size_t println(double, int = 2);
     size_t println(const Printable&);
     size_t println(void);
+
+    // Formats straight into write() through a small stack buffer, without
+    // newlib or the heap. Supports flags - 0 + space #, width, precision
+    // (also as *), the h hh l ll z length modifiers and the conversions
+    // d i u x X o c s f F e E g G p %. Floats resolve up to 17 significant
+    // digits, or 19 decimals with f.
+    size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3)));
+    size_t vprintf(const char *format, va_list args);
 };
 
 #endif
@@ -17,6 +17,7 @@
 */
 
 #include "RingBuffer.h"
+#include "ramfunc.h"
 #include <string.h>
 
 RingBuffer::RingBuffer( void )
@@ -25,7 +26,7 @@ RingBuffer::RingBuffer( void )
     clear();
 }
 
-void RingBuffer::store_char( uint8_t c )
+CORE_ISR_RAMFUNC void RingBuffer::store_char( uint8_t c )
 {
   int i = nextIndex(_iHead);
 
@@ -40,13 +41,47 @@ void RingBuffer::store_char( uint8_t c )
   }
 }
 
+size_t RingBuffer::store_chars( const uint8_t *data, size_t length )
+{
+  size_t stored = 0;
+
+  while ( stored < length )
+  {
+    int space = availableForStore();
+
+    if ( space == 0 )
+    {
+      break;
+    }
+
+    // contiguous part up to the end of the array
+    size_t chunk = SERIAL_BUFFER_SIZE - _iHead;
+
+    if ( chunk > (size_t)space )
+    {
+      chunk = space;
+    }
+
+    if ( chunk > length - stored )
+    {
+      chunk = length - stored;
+    }
+
+    memcpy( &_aucBuffer[_iHead], data + stored, chunk );
+    _iHead = (uint32_t)(_iHead + chunk) % SERIAL_BUFFER_SIZE;
+    stored += chunk;
+  }
+
+  return stored;
+}
+
 void RingBuffer::clear()
 {
 	_iHead = 0;
 	_iTail = 0;
 }
 
-int RingBuffer::read_char()
+CORE_ISR_RAMFUNC int RingBuffer::read_char()
 {
 	if(_iTail == _iHead)
 		return -1;
@@ -57,6 +92,35 @@ int RingBuffer::read_char()
 	return value;
 }
 
+size_t RingBuffer::read_chars( uint8_t *data, size_t length )
+{
+  size_t count = 0;
+
+  while ( count < length )
+  {
+    int head = _iHead;
+
+    if ( head == _iTail )
+    {
+      break;
+    }
+
+    // contiguous part up to the head or the end of the array
+    size_t chunk = (head > _iTail ? head : SERIAL_BUFFER_SIZE) - _iTail;
+
+    if ( chunk > length - count )
+    {
+      chunk = length - count;
+    }
+
+    memcpy( data + count, &_aucBuffer[_iTail], chunk );
+    _iTail = (uint32_t)(_iTail + chunk) % SERIAL_BUFFER_SIZE;
+    count += chunk;
+  }
+
+  return count;
+}
+
 int RingBuffer::available()
 {
 	int delta = _iHead - _iTail;
@@ -84,3 +148,9 @@ bool RingBuffer::isFull()
 {
 	return (nextIndex(_iHead) == _iTail);
 }
+
+int RingBuffer::availableForStore()
+{
+	// one slot always stays free to tell a full buffer from an empty one
+	return SERIAL_BUFFER_SIZE - 1 - available();
+}
@@ -20,6 +20,7 @@
 #define _RING_BUFFER_
 
 #include <stdint.h>
+#include <stddef.h>
 
 // Define constants and variables for buffering incoming serial data.  We're
 // using a ring buffer (I think), in which head is the index of the location
@@ -37,11 +38,16 @@ class RingBuffer
   public:
     RingBuffer( void ) ;
     void store_char( uint8_t c ) ;
+    // copies as much of data as fits, returns the number of bytes stored
+    size_t store_chars( const uint8_t *data, size_t length ) ;
 	void clear();
 	int read_char();
+	// copies up to length bytes out, returns the number of bytes read
+	size_t read_chars( uint8_t *data, size_t length ) ;
 	int available();
 	int peek();
 	bool isFull();
+	int availableForStore();
 
   private:
 	int nextIndex(int index);
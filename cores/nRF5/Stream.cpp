@@ -30,7 +30,9 @@
 // private method to read stream with timeout
 int Stream::timedRead()
 {
-  int c;
+  // only start the clock once the stream has run dry
+  int c = read();
+  if (c >= 0) return c;
   _startMillis = millis();
   do {
     c = read();
@@ -42,7 +44,8 @@ int Stream::timedRead()
 // private method to peek stream with timeout
 int Stream::timedPeek()
 {
-  int c;
+  int c = peek();
+  if (c >= 0) return c;
   _startMillis = millis();
   do {
     c = peek();
@@ -84,6 +87,19 @@ int Stream::peekNextDigit(LookaheadMode lookahead, bool detectDecimal)
 // Public Methods
 //////////////////////////////////////////////////////////////
 
+// copies what is already available one byte at a time, streams that can do
+// better override it
+int Stream::read(uint8_t *buffer, size_t length)
+{
+  size_t count = 0;
+  while (count < length) {
+    int c = read();
+    if (c < 0) break;
+    buffer[count++] = (uint8_t)c;
+  }
+  return count;
+}
+
 void Stream::setTimeout(unsigned long timeout)  // sets the maximum number of milliseconds to wait
 {
   _timeout = timeout;
@@ -102,6 +118,12 @@ bool Stream::find(char *target, size_t length)
   return findUntil(target, length, NULL, 0);
 }
 
+bool Stream::find(StringView target)
+{
+  MultiTarget t[1] = {{target.data(), target.length(), 0}};
+  return findMulti(t, 1) == 0;
+}
+
 // as find but search ends if the terminator string is found
 bool  Stream::findUntil(char *target, char *terminator)
 {
@@ -122,6 +144,12 @@ bool Stream::findUntil(char *target, size_t targetLen, char *terminator, size_t
   }
 }
 
+bool Stream::findUntil(StringView target, StringView terminator)
+{
+  MultiTarget t[2] = {{target.data(), target.length(), 0}, {terminator.data(), terminator.length(), 0}};
+  return findMulti(t, 2) == 0;
+}
+
 // returns the first valid (long) integer value from the current position.
 // lookahead determines how parseInt looks ahead in the stream.
 // See LookaheadMode enumeration at the top of the file.
@@ -203,10 +231,15 @@ size_t Stream::readBytes(char *buffer, size_t length)
 {
   size_t count = 0;
   while (count < length) {
+    // take everything already buffered, wait only when nothing is
+    int n = read((uint8_t *)buffer + count, length - count);
+    if (n > 0) {
+      count += n;
+      continue;
+    }
     int c = timedRead();
     if (c < 0) break;
-    *buffer++ = (char)c;
-    count++;
+    buffer[count++] = (char)c;
   }
   return count;
 }
@@ -232,11 +265,19 @@ size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length)
 String Stream::readString()
 {
   String ret;
-  int c = timedRead();
-  while (c >= 0)
+  char chunk[32];
+  while (1)
   {
-    ret += (char)c;
-    c = timedRead();
+    int n = read((uint8_t *)chunk, sizeof(chunk));
+    if (n <= 0)
+    {
+      int c = timedRead();
+      if (c < 0) break;
+      chunk[0] = (char)c;
+      n = 1;
+    }
+    // by length, a zero byte doesn't end the data
+    ret.concat(StringView(chunk, n));
   }
   return ret;
 }
@@ -253,6 +294,22 @@ String Stream::readStringUntil(char terminator)
   return ret;
 }
 
+size_t Stream::readString(char *buffer, size_t size)
+{
+  if (size == 0) return 0;
+  size_t n = readBytes(buffer, size - 1);
+  buffer[n] = '\0';
+  return n;
+}
+
+size_t Stream::readStringUntil(char terminator, char *buffer, size_t size)
+{
+  if (size == 0) return 0;
+  size_t n = readBytesUntil(terminator, buffer, size - 1);
+  buffer[n] = '\0';
+  return n;
+}
+
 int Stream::findMulti( struct Stream::MultiTarget *targets, int tCount) {
   // any zero length target string automatically matches and would make
   // a mess of the rest of the algorithm.
@@ -61,6 +61,11 @@ class Stream : public Print
     virtual int peek() = 0;
     virtual void flush() = 0;
 
+    // Copies up to length bytes that have already arrived, never waits.
+    // Returns the number of bytes copied, 0 (or less) if none are waiting.
+    // Override it when the data can be moved more cheaply than with read().
+    virtual int read(uint8_t *buffer, size_t length);
+
     Stream() {_timeout=1000;}
 
 // parsing methods
@@ -77,10 +82,13 @@ class Stream : public Print
 
   bool find(char target) { return find (&target, 1); }
 
+  bool find(StringView target);   // as above, for literals, F() strings, Strings and buffers
+
   bool findUntil(char *target, char *terminator);   // as find but search ends if the terminator string is found
   bool findUntil(uint8_t *target, char *terminator) { return findUntil((char *)target, terminator); }
 
   bool findUntil(char *target, size_t targetLen, char *terminate, size_t termLen);   // as above but search ends if the terminate string is found
+  bool findUntil(StringView target, StringView terminator);
   bool findUntil(uint8_t *target, size_t targetLen, char *terminate, size_t termLen) {return findUntil((char *)target, targetLen, terminate, termLen); }
 
   long parseInt(LookaheadMode lookahead = SKIP_ALL, char ignore = NO_IGNORE_CHAR);
@@ -107,6 +115,11 @@ class Stream : public Print
   String readString();
   String readStringUntil(char terminator);
 
+  // allocation free versions, read at most size - 1 characters into buffer
+  // and zero terminate it. Return the length of the string.
+  size_t readString(char *buffer, size_t size);
+  size_t readStringUntil(char terminator, char *buffer, size_t size);
+
   protected:
   long parseInt(char ignore) { return parseInt(SKIP_ALL, ignore); }
   float parseFloat(char ignore) { return parseFloat(SKIP_ALL, ignore); }
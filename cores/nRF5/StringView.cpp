@@ -0,0 +1,118 @@
+/*
+  StringView.cpp - Non-owning view of characters for Arduino
+  Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <ctype.h>
+
+#include "StringView.h"
+#include "WString.h"
+
+StringView::StringView(const String &str) : ptr(str.c_str() ? str.c_str() : ""), len(str.length()) {}
+
+/*********************************************/
+/*  Comparison                               */
+/*********************************************/
+
+int StringView::compareTo(StringView s) const
+{
+	int diff = memcmp(ptr, s.ptr, (len < s.len) ? len : s.len);
+	if (diff) return diff;
+	if (len == s.len) return 0;
+	return (len < s.len) ? -1 : 1;
+}
+
+bool StringView::equalsIgnoreCase(StringView s) const
+{
+	if (len != s.len) return false;
+	for (size_t i = 0; i < len; i++) {
+		if (tolower((unsigned char)ptr[i]) != tolower((unsigned char)s.ptr[i])) return false;
+	}
+	return true;
+}
+
+/*********************************************/
+/*  Search                                   */
+/*********************************************/
+
+int StringView::indexOf(char ch, size_t fromIndex) const
+{
+	if (fromIndex >= len) return -1;
+	const char *found = (const char *)memchr(ptr + fromIndex, ch, len - fromIndex);
+	if (found == NULL) return -1;
+	return found - ptr;
+}
+
+int StringView::indexOf(StringView s, size_t fromIndex) const
+{
+	if (fromIndex > len || s.len > len - fromIndex) return -1;
+	if (s.len == 0) return fromIndex;
+	// only positions where the first character matches are compared
+	for (size_t i = fromIndex; i + s.len <= len; i++) {
+		const char *found = (const char *)memchr(ptr + i, s.ptr[0], len - s.len + 1 - i);
+		if (found == NULL) return -1;
+		i = found - ptr;
+		if (memcmp(found + 1, s.ptr + 1, s.len - 1) == 0) return i;
+	}
+	return -1;
+}
+
+int StringView::lastIndexOf(char ch) const
+{
+	for (size_t i = len; i > 0; i--) {
+		if (ptr[i - 1] == ch) return i - 1;
+	}
+	return -1;
+}
+
+StringView StringView::substring(size_t left, size_t right) const
+{
+	if (left > right) {
+		size_t temp = right;
+		right = left;
+		left = temp;
+	}
+	if (left >= len) return StringView();
+	if (right > len) right = len;
+	return StringView(ptr + left, right - left);
+}
+
+StringView StringView::trim() const
+{
+	size_t begin = 0;
+	size_t end = len;
+	while (begin < end && isspace((unsigned char)ptr[begin])) begin++;
+	while (end > begin && isspace((unsigned char)ptr[end - 1])) end--;
+	return StringView(ptr + begin, end - begin);
+}
+
+/*********************************************/
+/*  Parsing / Conversion                     */
+/*********************************************/
+
+long StringView::toInt() const
+{
+	size_t i = 0;
+	bool negative = false;
+	unsigned long value = 0;
+
+	while (i < len && isspace((unsigned char)ptr[i])) i++;
+	if (i < len && (ptr[i] == '-' || ptr[i] == '+')) negative = (ptr[i++] == '-');
+	while (i < len && ptr[i] >= '0' && ptr[i] <= '9') value = value * 10 + (ptr[i++] - '0');
+
+	return negative ? -(long)value : (long)value;
+}
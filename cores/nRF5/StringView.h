@@ -0,0 +1,82 @@
+/*
+  StringView.h - Non-owning view of characters for Arduino
+  Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef StringView_h
+#define StringView_h
+#ifdef __cplusplus
+
+#include <stddef.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+
+class String;
+class __FlashStringHelper;
+
+// A pointer and a length: looks at characters owned by someone else (a
+// literal, an F() string, a String or a receive buffer) without copying
+// them. Need not be '\0' terminated, and is only valid as long as the
+// characters it looks at. Searches return -1 when nothing is found.
+class StringView
+{
+public:
+	StringView() : ptr(""), len(0) {}
+	StringView(const char *cstr) : ptr(cstr ? cstr : ""), len(cstr ? strlen(cstr) : 0) {}
+	StringView(const char *data, size_t length) : ptr(data ? data : ""), len(data ? length : 0) {}
+	// flash is memory mapped, F() strings are used in place
+	StringView(const __FlashStringHelper *str) : ptr(str ? (PGM_P)str : ""), len(str ? strlen_P((PGM_P)str) : 0) {}
+	StringView(const String &str);
+
+	const char *data() const { return ptr; }
+	size_t length() const { return len; }
+	char operator [] (size_t index) const { return (index < len) ? ptr[index] : 0; }
+
+	// comparison
+	int compareTo(StringView s) const;
+	bool equals(StringView s) const { return len == s.len && memcmp(ptr, s.ptr, len) == 0; }
+	bool equalsIgnoreCase(StringView s) const;
+	bool operator == (StringView rhs) const { return equals(rhs); }
+	bool operator != (StringView rhs) const { return !equals(rhs); }
+	bool operator <  (StringView rhs) const { return compareTo(rhs) < 0; }
+	bool operator >  (StringView rhs) const { return compareTo(rhs) > 0; }
+	bool operator <= (StringView rhs) const { return compareTo(rhs) <= 0; }
+	bool operator >= (StringView rhs) const { return compareTo(rhs) >= 0; }
+	bool startsWith(StringView prefix) const { return len >= prefix.len && memcmp(ptr, prefix.ptr, prefix.len) == 0; }
+	bool endsWith(StringView suffix) const { return len >= suffix.len && memcmp(ptr + len - suffix.len, suffix.ptr, suffix.len) == 0; }
+
+	// search
+	int indexOf(char ch, size_t fromIndex = 0) const;
+	int indexOf(StringView s, size_t fromIndex = 0) const;
+	int lastIndexOf(char ch) const;
+
+	// views of part of this one, indexes as in String::substring()
+	StringView substring(size_t beginIndex) const { return substring(beginIndex, len); }
+	StringView substring(size_t beginIndex, size_t endIndex) const;
+	// without leading and trailing whitespace
+	StringView trim() const;
+
+	// parsing, as atol(), without needing a terminator
+	long toInt() const;
+
+private:
+	const char *ptr;
+	size_t len;
+};
+
+#endif  // __cplusplus
+#endif  // StringView_h
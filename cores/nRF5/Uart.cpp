@@ -28,6 +28,7 @@ Uart::Uart(NRF_UART_Type *_nrfUart, IRQn_Type _IRQn, uint8_t _pinRX, uint8_t _pi
   uc_pinRX = g_ADigitalPinMap[_pinRX];
   uc_pinTX = g_ADigitalPinMap[_pinTX];
   uc_hwFlow = 0;
+  transmitting = false;
 }
 
 Uart::Uart(NRF_UART_Type *_nrfUart, IRQn_Type _IRQn, uint8_t _pinRX, uint8_t _pinTX, uint8_t _pinCTS, uint8_t _pinRTS)
@@ -39,6 +40,7 @@ Uart::Uart(NRF_UART_Type *_nrfUart, IRQn_Type _IRQn, uint8_t _pinRX, uint8_t _pi
   uc_pinCTS = g_ADigitalPinMap[_pinCTS];
   uc_pinRTS = g_ADigitalPinMap[_pinRTS];
   uc_hwFlow = 1;
+  transmitting = false;
 }
 
 #ifdef ARDUINO_GENERIC
@@ -158,7 +160,10 @@ void Uart::begin(unsigned long baudrate, uint16_t /*config*/)
   nrfUart->TASKS_STARTRX = 0x1UL;
   nrfUart->TASKS_STARTTX = 0x1UL;
 
-  nrfUart->INTENSET = UART_INTENSET_RXDRDY_Msk;
+  transmitting = false;
+  txBuffer.clear();
+
+  nrfUart->INTENSET = UART_INTENSET_RXDRDY_Msk | UART_INTENSET_TXDRDY_Msk;
 
   NVIC_ClearPendingIRQ(IRQn);
   NVIC_SetPriority(IRQn, 3);
@@ -167,9 +172,11 @@ void Uart::begin(unsigned long baudrate, uint16_t /*config*/)
 
 void Uart::end()
 {
+  flush();
+
   NVIC_DisableIRQ(IRQn);
 
-  nrfUart->INTENCLR = UART_INTENCLR_RXDRDY_Msk;
+  nrfUart->INTENCLR = UART_INTENCLR_RXDRDY_Msk | UART_INTENCLR_TXDRDY_Msk;
 
   nrfUart->TASKS_STOPRX = 0x1UL;
   nrfUart->TASKS_STOPTX = 0x1UL;
@@ -183,13 +190,29 @@ void Uart::end()
   nrfUart->PSELCTS = 0xFFFFFFFF;
 
   rxBuffer.clear();
+  txBuffer.clear();
 }
 
 void Uart::flush()
 {
+  while (transmitting)
+  {
+    waitTx();
+  }
+}
+
+void Uart::waitTx()
+{
+  // still pending means the UART interrupt can't preempt the caller
+  // (interrupts masked or called from an ISR of same or higher priority)
+  if (NVIC_GetPendingIRQ(IRQn))
+  {
+    NVIC_ClearPendingIRQ(IRQn);
+    IrqHandler();
+  }
 }
 
-void Uart::IrqHandler()
+CORE_ISR_RAMFUNC void Uart::IrqHandler()
 {
   if (nrfUart->EVENTS_RXDRDY)
   {
@@ -197,6 +220,22 @@ void Uart::IrqHandler()
 
     nrfUart->EVENTS_RXDRDY = 0x0UL;
   }
+
+  if (nrfUart->EVENTS_TXDRDY)
+  {
+    nrfUart->EVENTS_TXDRDY = 0x0UL;
+
+    int c = txBuffer.read_char();
+
+    if (c < 0)
+    {
+      transmitting = false;
+    }
+    else
+    {
+      nrfUart->TXD = c;
+    }
+  }
 }
 
 int Uart::available()
@@ -214,15 +253,49 @@ int Uart::read()
   return rxBuffer.read_char();
 }
 
+int Uart::read(uint8_t *buffer, size_t size)
+{
+  return rxBuffer.read_chars(buffer, size);
+}
+
+int Uart::availableForWrite()
+{
+  return txBuffer.availableForStore();
+}
+
 size_t Uart::write(const uint8_t data)
 {
-  nrfUart->TXD = data;
+  return write(&data, 1);
+}
 
-  while(!nrfUart->EVENTS_TXDRDY);
+size_t Uart::write(const uint8_t *buffer, size_t size)
+{
+  size_t written = 0;
 
-  nrfUart->EVENTS_TXDRDY = 0x0UL;
+  while (written < size)
+  {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!transmitting)
+    {
+      // idle, the first byte goes straight out
+      transmitting = true;
+      nrfUart->TXD = buffer[written++];
+    }
+
+    written += txBuffer.store_chars(buffer + written, size - written);
+
+    __set_PRIMASK(primask);
+
+    if (written < size)
+    {
+      // buffer full
+      waitTx();
+    }
+  }
 
-  return 1;
+  return size;
 }
 
 #if defined(NRF52_SERIES)
@@ -240,7 +313,7 @@ size_t Uart::write(const uint8_t data)
 #if defined(NRF52_SERIES)
 extern "C"
 {
-  void UARTE0_UART0_IRQHandler()
+  CORE_ISR_RAMFUNC void UARTE0_UART0_IRQHandler()
   {
     Serial.IrqHandler();
   }
@@ -248,7 +321,7 @@ extern "C"
 #elif defined(NRF51_SERIES)
 extern "C"
 {
-  void UART0_IRQHandler()
+  CORE_ISR_RAMFUNC void UART0_IRQHandler()
   {
     Serial.IrqHandler();
   }
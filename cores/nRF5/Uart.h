@@ -41,17 +41,25 @@ class Uart : public HardwareSerial
     int available();
     int peek();
     int read();
+    int read(uint8_t *buffer, size_t size);
     void flush();
     size_t write(const uint8_t data);
-    using Print::write; // pull in write(str) and write(buf, size) from Print
+    size_t write(const uint8_t *buffer, size_t size);
+    int availableForWrite();
+    using Print::write; // pull in write(str) from Print
 
     void IrqHandler();
 
     operator bool() { return true; }
 
   private:
+    void waitTx();
+
     NRF_UART_Type *nrfUart;
     RingBuffer rxBuffer;
+    // drained a byte per TXDRDY interrupt
+    RingBuffer txBuffer;
+    volatile bool transmitting;
 
     IRQn_Type IRQn;
 
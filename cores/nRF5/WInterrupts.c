@@ -125,7 +125,7 @@ void detachInterrupt(uint32_t pin)
   }
 }
 
-void GPIOTE_IRQHandler()
+CORE_ISR_RAMFUNC void GPIOTE_IRQHandler()
 {
   uint32_t event = offsetof(NRF_GPIOTE_Type, EVENTS_IN[0]);
 
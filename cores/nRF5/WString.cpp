@@ -19,7 +19,10 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#include <math.h>
+
 #include "WString.h"
+#include "Print.h"
 #include "itoa.h"
 #include "avr/dtostrf.h"
 
@@ -45,6 +48,15 @@ String::String(const __FlashStringHelper *pstr)
 	*this = pstr;
 }
 
+String::String(StringView view)
+{
+	init();
+	if (!reserve(view.length())) return;
+	memcpy(buffer, view.data(), view.length());
+	len = view.length();
+	buffer[len] = 0;
+}
+
 #if __cplusplus >= 201103L || defined(__GXX_EXPERIMENTAL_CXX0X__)
 String::String(String &&rval)
 {
@@ -71,7 +83,7 @@ String::String(unsigned char value, unsigned char base)
 {
 	init();
 	char buf[1 + 8 * sizeof(unsigned char)];
-	utoa(value, buf, base);
+	ultoa(value, buf, base);
 	*this = buf;
 }
 
@@ -79,7 +91,7 @@ String::String(int value, unsigned char base)
 {
 	init();
 	char buf[2 + 8 * sizeof(int)];
-	itoa(value, buf, base);
+	ltoa(value, buf, base);
 	*this = buf;
 }
 
@@ -87,7 +99,7 @@ String::String(unsigned int value, unsigned char base)
 {
 	init();
 	char buf[1 + 8 * sizeof(unsigned int)];
-	utoa(value, buf, base);
+	ultoa(value, buf, base);
 	*this = buf;
 }
 
@@ -110,20 +122,18 @@ String::String(unsigned long value, unsigned char base)
 String::String(float value, unsigned char decimalPlaces)
 {
 	init();
-	char buf[33];
-	*this = dtostrf(value, (decimalPlaces + 2), decimalPlaces, buf);
+	concat(value, decimalPlaces);
 }
 
 String::String(double value, unsigned char decimalPlaces)
 {
 	init();
-	char buf[33];
-	*this = dtostrf(value, (decimalPlaces + 2), decimalPlaces, buf);
+	concat(value, decimalPlaces);
 }
 
 String::~String()
 {
-	free(buffer);
+	release();
 }
 
 /*********************************************/
@@ -137,9 +147,14 @@ inline void String::init(void)
 	len = 0;
 }
 
+void String::release(void)
+{
+	if (buffer != inlineBuffer) free(buffer);
+}
+
 void String::invalidate(void)
 {
-	if (buffer) free(buffer);
+	release();
 	buffer = NULL;
 	capacity = len = 0;
 }
@@ -156,12 +171,31 @@ unsigned char String::reserve(unsigned int size)
 
 unsigned char String::changeBuffer(unsigned int maxStrLen)
 {
-	char *newbuffer = (char *)realloc(buffer, maxStrLen + 1);
-	if (newbuffer) {
-		buffer = newbuffer;
-		capacity = maxStrLen;
+	if (!buffer && maxStrLen < STRING_INLINE_SIZE) {
+		buffer = inlineBuffer;
+		capacity = STRING_INLINE_SIZE - 1;
 		return 1;
 	}
+
+	// grow geometrically once there is something to grow, but settle for
+	// the exact size when the heap can't spare the slack
+	unsigned int sizes[2] = { maxStrLen, maxStrLen };
+	if (buffer && capacity + capacity / 2 > maxStrLen) sizes[0] = capacity + capacity / 2;
+
+	for (int i = 0; i < 2; i++) {
+		char *newbuffer;
+		if (buffer == inlineBuffer) {
+			newbuffer = (char *)malloc(sizes[i] + 1);
+			if (newbuffer) memcpy(newbuffer, inlineBuffer, len + 1);
+		} else {
+			newbuffer = (char *)realloc(buffer, sizes[i] + 1);
+		}
+		if (newbuffer) {
+			buffer = newbuffer;
+			capacity = sizes[i];
+			return 1;
+		}
+	}
 	return 0;
 }
 
@@ -195,15 +229,26 @@ String & String::copy(const __FlashStringHelper *pstr, unsigned int length)
 void String::move(String &rhs)
 {
 	if (buffer) {
-		if (capacity >= rhs.len) {
+		if (rhs.buffer && capacity >= rhs.len) {
 			strcpy(buffer, rhs.buffer);
 			len = rhs.len;
 			rhs.len = 0;
+			rhs.buffer[0] = 0;
 			return;
 		} else {
-			free(buffer);
+			release();
 		}
 	}
+	if (rhs.buffer == rhs.inlineBuffer) {
+		// nothing to steal, the characters have to be copied
+		memcpy(inlineBuffer, rhs.inlineBuffer, rhs.len + 1);
+		buffer = inlineBuffer;
+		capacity = rhs.capacity;
+		len = rhs.len;
+		rhs.len = 0;
+		rhs.inlineBuffer[0] = 0;
+		return;
+	}
 	buffer = rhs.buffer;
 	capacity = rhs.capacity;
 	len = rhs.len;
@@ -290,21 +335,21 @@ unsigned char String::concat(char c)
 unsigned char String::concat(unsigned char num)
 {
 	char buf[1 + 3 * sizeof(unsigned char)];
-	itoa(num, buf, 10);
+	ltoa(num, buf, 10);
 	return concat(buf, strlen(buf));
 }
 
 unsigned char String::concat(int num)
 {
 	char buf[2 + 3 * sizeof(int)];
-	itoa(num, buf, 10);
+	ltoa(num, buf, 10);
 	return concat(buf, strlen(buf));
 }
 
 unsigned char String::concat(unsigned int num)
 {
 	char buf[1 + 3 * sizeof(unsigned int)];
-	utoa(num, buf, 10);
+	ultoa(num, buf, 10);
 	return concat(buf, strlen(buf));
 }
 
@@ -324,16 +369,25 @@ unsigned char String::concat(unsigned long num)
 
 unsigned char String::concat(float num)
 {
-	char buf[20];
-	char* string = dtostrf(num, 4, 2, buf);
-	return concat(string, strlen(string));
+	return concat(num, 2);
 }
 
 unsigned char String::concat(double num)
 {
-	char buf[20];
-	char* string = dtostrf(num, 4, 2, buf);
-	return concat(string, strlen(string));
+	return concat(num, 2);
+}
+
+unsigned char String::concat(double num, unsigned char decimalPlaces)
+{
+	// every integer digit of large values, formatted in place rather
+	// than in a stack buffer that could hold them
+	if (fabs(num) >= FMTDOUBLE_LARGE && !isinf(num)) {
+		if (!reserve(len + FMTDOUBLE_LARGE_BUFFER_SIZE(decimalPlaces))) return 0;
+		len += fmtdouble(num, decimalPlaces, buffer + len);
+		return 1;
+	}
+	char buf[FMTDOUBLE_BUFFER_SIZE(FMTDOUBLE_MAX_PREC)];
+	return concat(buf, fmtdouble(num, decimalPlaces, buf));
 }
 
 unsigned char String::concat(const __FlashStringHelper * str)
@@ -348,6 +402,136 @@ unsigned char String::concat(const __FlashStringHelper * str)
 	return 1;
 }
 
+unsigned char String::concat(const StringJoinPart *parts, unsigned int count)
+{
+	unsigned int newlen = len;
+	for (unsigned int i = 0; i < count; i++) newlen += parts[i].length();
+	if (!reserve(newlen)) return 0;
+	for (unsigned int i = 0; i < count; i++) {
+		parts[i].copyTo(buffer + len);
+		len += parts[i].length();
+	}
+	buffer[len] = 0;
+	return 1;
+}
+
+/*********************************************/
+/*  Join and Format                          */
+/*********************************************/
+
+StringJoinPart::StringJoinPart(const String &str) : ptr(str.c_str() ? str.c_str() : ""), len(str.length()), large(false) {}
+
+StringJoinPart::StringJoinPart(char c) : ptr(NULL), len(1), large(false)
+{
+	buf[0] = c;
+	buf[1] = 0;
+}
+
+StringJoinPart::StringJoinPart(unsigned char num) : ptr(NULL), large(false)
+{
+	len = strlen(ultoa(num, buf, 10));
+}
+
+StringJoinPart::StringJoinPart(int num) : ptr(NULL), large(false)
+{
+	len = strlen(ltoa(num, buf, 10));
+}
+
+StringJoinPart::StringJoinPart(unsigned int num) : ptr(NULL), large(false)
+{
+	len = strlen(ultoa(num, buf, 10));
+}
+
+StringJoinPart::StringJoinPart(long num) : ptr(NULL), large(false)
+{
+	len = strlen(ltoa(num, buf, 10));
+}
+
+StringJoinPart::StringJoinPart(unsigned long num) : ptr(NULL), large(false)
+{
+	len = strlen(ultoa(num, buf, 10));
+}
+
+StringJoinPart::StringJoinPart(float num) : StringJoinPart((double)num) {}
+
+StringJoinPart::StringJoinPart(double num) : ptr(NULL), large(fabs(num) >= FMTDOUBLE_LARGE && !isinf(num))
+{
+	if (large) {
+		value = num;
+		len = fmtdoublelength(num, 2);
+	} else {
+		len = fmtdouble(num, 2, buf);
+	}
+}
+
+void StringJoinPart::copyTo(char *dest) const
+{
+	if (large) fmtdouble(value, 2, dest);
+	else memcpy(dest, ptr ? ptr : buf, len);
+}
+
+// Collects vprintf() output into a fixed buffer, or only counts it when
+// there is none.
+class StringFormatter : public Print
+{
+public:
+	StringFormatter(char *buffer, size_t size) : buffer(buffer), size(size), count(0) {}
+
+	size_t write(uint8_t c) { return write(&c, 1); }
+	size_t write(const uint8_t *data, size_t length)
+	{
+		if (count < size) memcpy(buffer + count, data, (length < size - count) ? length : size - count);
+		count += length;
+		return length;
+	}
+
+private:
+	char *buffer;
+	size_t size;
+	size_t count;
+};
+
+String String::format(const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	String out = vformat(format, args);
+	va_end(args);
+	return out;
+}
+
+String String::vformat(const char *format, va_list args)
+{
+	va_list again;
+	va_copy(again, args);
+
+	StringFormatter counter(NULL, 0);
+	size_t length = counter.vprintf(format, args);
+
+	String out;
+	if (out.reserve(length)) {
+		StringFormatter writer(out.buffer, length);
+		writer.vprintf(format, again);
+		out.buffer[length] = 0;
+		out.len = length;
+	} else {
+		out.invalidate();
+	}
+
+	va_end(again);
+	return out;
+}
+
+unsigned char String::concat(StringView view)
+{
+	if (view.length() == 0) return 1;
+	if (!reserve(len + view.length())) return 0;
+	memcpy(buffer + len, view.data(), view.length());
+	len += view.length();
+	buffer[len] = 0;
+	return 1;
+}
+
 /*********************************************/
 /*  Concatenate                              */
 /*********************************************/
@@ -455,6 +639,11 @@ unsigned char String::equals(const char *cstr) const
 	return strcmp(buffer, cstr) == 0;
 }
 
+unsigned char String::equals(StringView view) const
+{
+	return StringView(*this) == view;
+}
+
 unsigned char String::operator<(const String &rhs) const
 {
 	return compareTo(rhs) < 0;
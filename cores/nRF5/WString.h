@@ -26,7 +26,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdarg.h>
 #include <avr/pgmspace.h>
+#include "avr/dtostrf.h"
+#include "StringView.h"
 
 // When compiling programs with this class, the following gcc parameters
 // dramatically increase performance and memory (RAM) efficiency, typically
@@ -34,6 +37,13 @@
 //     -felide-constructors
 //     -std=c++0x
 
+// Strings shorter than this live inside the String object itself and never
+// touch the heap. Longer ones grow their heap buffer by half again each time
+// it runs out, so building a string piece by piece doesn't realloc per piece.
+#ifndef STRING_INLINE_SIZE
+#define STRING_INLINE_SIZE 12
+#endif
+
 class __FlashStringHelper;
 #define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
 
@@ -41,6 +51,43 @@ class __FlashStringHelper;
 // result objects are assumed to be writable by subsequent concatenations.
 class StringSumHelper;
 
+class String;
+
+// One piece of a String::join(): strings are referenced, numbers formatted
+// into the piece itself the way concat() would format them.
+class StringJoinPart
+{
+public:
+	StringJoinPart(const String &str);
+	StringJoinPart(StringView view) : ptr(view.data()), len(view.length()), large(false) {}
+	StringJoinPart(const char *cstr) : ptr(cstr ? cstr : ""), len(cstr ? strlen(cstr) : 0), large(false) {}
+	StringJoinPart(const __FlashStringHelper *str) : ptr(str ? (PGM_P)str : ""), len(str ? strlen_P((PGM_P)str) : 0), large(false) {}
+	StringJoinPart(char c);
+	StringJoinPart(unsigned char num);
+	StringJoinPart(int num);
+	StringJoinPart(unsigned int num);
+	StringJoinPart(long num);
+	StringJoinPart(unsigned long num);
+	StringJoinPart(float num);
+	StringJoinPart(double num);
+
+	unsigned int length() const { return len; }
+	// writes the characters to dest, which has room for one more
+	void copyTo(char *dest) const;
+
+private:
+	// NULL while the characters are in buf, so copies stay valid
+	const char *ptr;
+	unsigned int len;
+	// doubles at or beyond FMTDOUBLE_LARGE don't fit buf, they're only
+	// formatted by copyTo()
+	bool large;
+	union {
+		char buf[FMTDOUBLE_BUFFER_SIZE(2)];
+		double value;
+	};
+};
+
 // The string class
 class String
 {
@@ -59,6 +106,7 @@ public:
 	String(const char *cstr = "");
 	String(const String &str);
 	String(const __FlashStringHelper *str);
+	explicit String(StringView view);
        #if __cplusplus >= 201103L || defined(__GXX_EXPERIMENTAL_CXX0X__)
 	String(String &&rval);
 	String(StringSumHelper &&rval);
@@ -107,6 +155,7 @@ public:
 	unsigned char concat(float num);
 	unsigned char concat(double num);
 	unsigned char concat(const __FlashStringHelper * str);
+	unsigned char concat(StringView view);
 
 	// if there's not enough memory for the concatenated value, the string
 	// will be left unchanged (but this isn't signalled in any way)
@@ -121,6 +170,25 @@ public:
 	String & operator += (float num)		{concat(num); return (*this);}
 	String & operator += (double num)		{concat(num); return (*this);}
 	String & operator += (const __FlashStringHelper *str){concat(str); return (*this);}
+	String & operator += (StringView view)		{concat(view); return (*this);}
+
+	// Concatenates all parts (Strings, strings, chars and numbers) with a
+	// single allocation, unlike a chain of + which grows the result piece by
+	// piece: String::join(name, ':', value, " ms")
+	template<typename... Parts> static String join(const Parts&... parts)
+	{
+		const StringJoinPart list[] = { StringJoinPart(parts)... };
+		String out;
+		if (!out.concat(list, sizeof...(parts))) out.invalidate();
+		return out;
+	}
+	// no parts, and no zero length array of them
+	static String join() { return String(); }
+
+	// printf into a new String (see Print::printf for the conversions),
+	// measured first so the buffer is allocated once
+	static String format(const char *format, ...) __attribute__ ((format (printf, 1, 2)));
+	static String vformat(const char *format, va_list args);
 
 	friend StringSumHelper & operator + (const StringSumHelper &lhs, const String &rhs);
 	friend StringSumHelper & operator + (const StringSumHelper &lhs, const char *cstr);
@@ -139,10 +207,17 @@ public:
 	int compareTo(const String &s) const;
 	unsigned char equals(const String &s) const;
 	unsigned char equals(const char *cstr) const;
+	unsigned char equals(StringView view) const;
 	unsigned char operator == (const String &rhs) const {return equals(rhs);}
 	unsigned char operator == (const char *cstr) const {return equals(cstr);}
 	unsigned char operator != (const String &rhs) const {return !equals(rhs);}
 	unsigned char operator != (const char *cstr) const {return !equals(cstr);}
+	unsigned char operator == (StringView rhs) const {return equals(rhs);}
+	unsigned char operator != (StringView rhs) const {return !equals(rhs);}
+	// exact matches, F() strings convert to both String and StringView
+	unsigned char equals(const __FlashStringHelper *str) const {return equals(StringView(str));}
+	unsigned char operator == (const __FlashStringHelper *rhs) const {return equals(rhs);}
+	unsigned char operator != (const __FlashStringHelper *rhs) const {return !equals(rhs);}
 	unsigned char operator <  (const String &rhs) const;
 	unsigned char operator >  (const String &rhs) const;
 	unsigned char operator <= (const String &rhs) const;
@@ -191,11 +266,15 @@ protected:
 	char *buffer;	        // the actual char array
 	unsigned int capacity;  // the array length minus one (for the '\0')
 	unsigned int len;       // the String length (not counting the '\0')
+	char inlineBuffer[STRING_INLINE_SIZE]; // buffer points here while it fits
 protected:
 	void init(void);
+	void release(void);
 	void invalidate(void);
 	unsigned char changeBuffer(unsigned int maxStrLen);
 	unsigned char concat(const char *cstr, unsigned int length);
+	unsigned char concat(const StringJoinPart *parts, unsigned int count);
+	unsigned char concat(double num, unsigned char decimalPlaces);
 
 	// copy and move
 	String & copy(const char *cstr, unsigned int length);
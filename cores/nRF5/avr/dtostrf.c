@@ -17,13 +17,342 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
-#include <stdio.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dtostrf.h"
+#include "../itoa.h"
+
+static const double powersOf10[FMTDOUBLE_MAX_PREC + 1] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+  1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19
+};
+
+// Integer digits of val, at or beyond 2^64 and so an exact integer, written
+// backwards from end unless end is NULL. The value is spread over 32-bit
+// limbs (a double stays below 2^1024) and divided by 10^9 per group of nine
+// digits. Returns the number of digits.
+static size_t largetostr(double val, char *end) {
+  uint32_t limbs[32] = { 0 };
+  int exponent;
+  uint64_t mantissa = (uint64_t)ldexp(frexp(val, &exponent), 53);
+  int shift = exponent - 53;
+  int n = shift / 32;
+  uint64_t low = mantissa << (shift % 32);
+
+  limbs[n] = (uint32_t)low;
+  limbs[n + 1] = (uint32_t)(low >> 32);
+  if (shift % 32) {
+    uint32_t high = (uint32_t)(mantissa >> (64 - shift % 32));
+    if (high) limbs[n + 2] = high;
+  }
+
+  n = 32;
+  while (limbs[n - 1] == 0) n--;
+
+  size_t length = 0;
+
+  while (n > 0) {
+    uint64_t rem = 0;
+
+    for (int i = n - 1; i >= 0; i--) {
+      rem = (rem << 32) | limbs[i];
+      limbs[i] = (uint32_t)(rem / 1000000000UL);
+      rem %= 1000000000UL;
+    }
+
+    while (n > 0 && limbs[n - 1] == 0) n--;
+
+    // the leading group isn't padded with zeros
+    int width = 9;
+    if (n == 0) {
+      for (width = 1; rem >= (uint64_t)powersOf10[width]; width++);
+    }
+
+    if (end) {
+      for (int i = 0; i < width; i++) {
+        *--end = '0' + rem % 10;
+        rem /= 10;
+      }
+    }
+
+    length += width;
+  }
+
+  return length;
+}
+
+size_t fmtdouble(double val, unsigned char prec, char *sout) {
+  char tmp[20];
+  char *end = &tmp[sizeof(tmp)];
+  char *sp = sout;
+  char *digits;
+
+  if (isnan(val)) {
+    strcpy(sout, "nan");
+    return 3;
+  }
+
+  if (signbit(val)) {
+    *sp++ = '-';
+    val = -val;
+  }
+
+  if (isinf(val)) {
+    strcpy(sp, "inf");
+    return sp + 3 - sout;
+  }
+
+  if (prec > FMTDOUBLE_MAX_PREC) {
+    prec = FMTDOUBLE_MAX_PREC;
+  }
+
+  // too large for the 64-bit fast path, but then there are no decimals
+  if (val >= FMTDOUBLE_LARGE) {
+    // counted first, so only the digits' room is written to
+    size_t length = largetostr(val, NULL);
+    largetostr(val, sp + length);
+    sp += length;
+
+    if (prec > 0) {
+      *sp++ = '.';
+      memset(sp, '0', prec);
+      sp += prec;
+    }
+
+    *sp = 0;
+
+    return sp - sout;
+  }
+
+  // both conversions are exact, the fraction is rounded once when scaled
+  unsigned long long integer = (unsigned long long)val;
+  double fraction = (val - (double)integer) * powersOf10[prec] + 0.5;
+  unsigned long long decimals = 0;
+
+  if (fraction >= powersOf10[prec]) {
+    integer++;
+  } else {
+    decimals = (unsigned long long)fraction;
+  }
+
+  digits = ulltostr(integer, end, 10, 0);
+  memcpy(sp, digits, end - digits);
+  sp += end - digits;
+
+  if (prec > 0) {
+    *sp++ = '.';
+
+    digits = ulltostr(decimals, end, 10, 0);
+
+    for (int zeros = prec - (end - digits); zeros > 0; zeros--) {
+      *sp++ = '0';
+    }
+
+    memcpy(sp, digits, end - digits);
+    sp += end - digits;
+  }
+
+  *sp = 0;
+
+  return sp - sout;
+}
+
+size_t fmtdoublelength(double val, unsigned char prec) {
+  if (isnan(val) || isinf(val) || fabs(val) < FMTDOUBLE_LARGE) {
+    char tmp[FMTDOUBLE_BUFFER_SIZE(FMTDOUBLE_MAX_PREC)];
+    return fmtdouble(val, prec, tmp);
+  }
+
+  if (prec > FMTDOUBLE_MAX_PREC) {
+    prec = FMTDOUBLE_MAX_PREC;
+  }
+
+  return (signbit(val) != 0) + largetostr(fabs(val), NULL) + (prec ? 1 + prec : 0);
+}
+
+// decimal powers of two, to scale by any power of ten in a few steps
+static const double binaryPowersOf10[] = {
+  1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256
+};
+
+// val times 10^power, growing or shrinking step by step so that not even
+// the denormals leave the range of a double on the way
+static double scale10(double val, int power) {
+  int shrink = power < 0;
+
+  if (shrink) {
+    power = -power;
+  }
+
+  for (int i = 0; power; i++, power >>= 1) {
+    if (power & 1) {
+      val = shrink ? val / binaryPowersOf10[i] : val * binaryPowersOf10[i];
+    }
+  }
+
+  return val;
+}
+
+// Rounds val (positive and finite) to count significant digits, at most 17,
+// and writes them to sout with leading zeros. Returns the decimal exponent of
+// the first digit.
+static int rounddigits(double val, int count, char *sout) {
+  char tmp[20];
+  char *end = &tmp[sizeof(tmp)];
+  int exponent = 0;
+  uint64_t digits = 0;
+
+  if (val != 0.0) {
+    int binary;
+    frexp(val, &binary);
+
+    // floor of log10(2^(binary - 1)), the exponent or one below it
+    double estimate = (binary - 1) * 0.30102999566398120;
+    exponent = (int)estimate;
+    if (exponent > estimate) exponent--;
+
+    double scaled = scale10(val, count - 1 - exponent);
+
+    if (scaled >= powersOf10[count]) {
+      exponent++;
+      scaled = scale10(val, count - 1 - exponent);
+    }
+
+    digits = (uint64_t)(scaled + 0.5);
+
+    // rounded up to the next power of ten
+    if (digits >= (uint64_t)powersOf10[count]) {
+      digits /= 10;
+      exponent++;
+    }
+  }
+
+  char *first = ulltostr(digits, end, 10, 0);
+
+  memset(sout, '0', count - (end - first));
+  memcpy(sout + count - (end - first), first, end - first);
+
+  return exponent;
+}
+
+// The %e and %g layouts of val: count significant digits with the point after
+// the first one and the exponent following, or as a plain decimal number.
+// exponential is negative for %g, which picks one and drops trailing zeros
+// unless alternate.
+static size_t fmtsignificant(double val, int count, int exponential, int upper, int alternate, char *sout) {
+  // room for the zeros of 0.000ddd
+  char digits[FMTEXPONENT_MAX_PREC + 4];
+  char *sp = sout;
+
+  if (isnan(val)) {
+    strcpy(sout, upper ? "NAN" : "nan");
+    return 3;
+  }
+
+  if (signbit(val)) {
+    *sp++ = '-';
+    val = -val;
+  }
+
+  if (isinf(val)) {
+    strcpy(sp, upper ? "INF" : "inf");
+    return sp + 3 - sout;
+  }
+
+  int exponent = rounddigits(val, count, digits);
+  const char *fraction = digits + 1;
+  int length = count - 1;
+
+  int strip = 0;
+
+  if (exponential < 0) {
+    // %g goes exponential where %f would need more than count digits
+    exponential = exponent < -4 || exponent >= count;
+    strip = !alternate;
+  }
+
+  if (exponential) {
+    *sp++ = digits[0];
+  } else if (exponent >= 0) {
+    memcpy(sp, digits, exponent + 1);
+    sp += exponent + 1;
+    fraction = digits + exponent + 1;
+    length = count - 1 - exponent;
+  } else {
+    // 0.000ddd, the leading zeros go in front of the digits
+    *sp++ = '0';
+    memmove(digits - exponent - 1, digits, count);
+    memset(digits, '0', -exponent - 1);
+    fraction = digits;
+    length = count - exponent - 1;
+  }
+
+  if (strip) {
+    while (length > 0 && fraction[length - 1] == '0') length--;
+  }
+
+  if (length > 0 || alternate) {
+    *sp++ = '.';
+    memcpy(sp, fraction, length);
+    sp += length;
+  }
+
+  if (exponential) {
+    *sp++ = upper ? 'E' : 'e';
+    *sp++ = exponent < 0 ? '-' : '+';
+
+    if (exponent < 0) {
+      exponent = -exponent;
+    }
+
+    if (exponent >= 100) {
+      *sp++ = '0' + exponent / 100;
+    }
+
+    *sp++ = '0' + exponent / 10 % 10;
+    *sp++ = '0' + exponent % 10;
+  }
+
+  *sp = 0;
+
+  return sp - sout;
+}
+
+size_t fmtexponent(double val, unsigned char prec, int upper, char *sout) {
+  if (prec > FMTEXPONENT_MAX_PREC) {
+    prec = FMTEXPONENT_MAX_PREC;
+  }
+
+  return fmtsignificant(val, prec + 1, 1, upper, 0, sout);
+}
+
+size_t fmtgeneral(double val, unsigned char prec, int upper, int alternate, char *sout) {
+  if (prec == 0) {
+    prec = 1;
+  } else if (prec > FMTEXPONENT_MAX_PREC + 1) {
+    prec = FMTEXPONENT_MAX_PREC + 1;
+  }
+
+  return fmtsignificant(val, prec, -1, upper, alternate, sout);
+}
 
 char *dtostrf (double val, signed char width, unsigned char prec, char *sout) {
-  asm(".global _printf_float");
+  size_t length = fmtdouble(val, prec, sout);
+  size_t pad = abs(width);
+
+  if (length < pad) {
+    if (width > 0) {
+      // right aligned
+      memmove(sout + pad - length, sout, length + 1);
+      memset(sout, ' ', pad - length);
+    } else {
+      memset(sout + length, ' ', pad - length);
+      sout[pad] = 0;
+    }
+  }
 
-  char fmt[20];
-  sprintf(fmt, "%%%d.%df", width, prec);
-  sprintf(sout, fmt, val);
   return sout;
 }
@@ -19,12 +19,55 @@
 
 #pragma once
 
+#include <stddef.h>
+
+// decimals fmtdouble() prints at most, they are scaled into 64 bits
+#define FMTDOUBLE_MAX_PREC 19
+
+// sign, 20 integer digits, point, decimals and the terminating zero
+#define FMTDOUBLE_BUFFER_SIZE(prec) (23 + (prec))
+
+// From 2^64 on the integer part doesn't fit the fast path any more and has
+// up to the 309 digits of DBL_MAX
+#define FMTDOUBLE_LARGE 18446744073709551616.0
+#define FMTDOUBLE_MAX_DIGITS 309
+#define FMTDOUBLE_LARGE_BUFFER_SIZE(prec) (FMTDOUBLE_MAX_DIGITS + 3 + (prec))
+
+// decimals fmtexponent() prints at most, the digits past the 17th significant
+// one aren't resolved
+#define FMTEXPONENT_MAX_PREC 16
+
+// sign, digit, point, decimals, e, exponent sign, 3 digits and the
+// terminating zero, also enough for fmtgeneral()
+#define FMTEXPONENT_BUFFER_SIZE(prec) (9 + (prec))
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 char *dtostrf(double val, signed char width, unsigned char prec, char *sout);
 
+// Formats val with prec decimals (rounded half up) into sout without
+// printf, every integer digit exact. Prints "nan" or "inf". sout holds
+// FMTDOUBLE_BUFFER_SIZE(prec) characters below FMTDOUBLE_LARGE and
+// FMTDOUBLE_LARGE_BUFFER_SIZE(prec) from there on. Returns the length.
+size_t fmtdouble(double val, unsigned char prec, char *sout);
+
+// The length fmtdouble() returns for val, without the buffer.
+size_t fmtdoublelength(double val, unsigned char prec);
+
+// Formats val as printf("%.*e") does, d.ddde+dd with prec decimals (rounded
+// half up, the last of 17 significant digits may be off by one), into sout.
+// upper selects E, NAN and INF. Returns the length.
+size_t fmtexponent(double val, unsigned char prec, int upper, char *sout);
+
+// Formats val as printf("%.*g") does: prec significant digits (at most 17),
+// exponential when the exponent is below -4 or not below prec, else like
+// fmtdouble(). Trailing zeros and the point are dropped unless alternate,
+// the # flag. sout holds FMTEXPONENT_BUFFER_SIZE(FMTEXPONENT_MAX_PREC).
+// Returns the length.
+size_t fmtgeneral(double val, unsigned char prec, int upper, int alternate, char *sout);
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,7 +56,7 @@ void delay( uint32_t ms )
   } while ( millis() - start < ms ) ;
 }
 
-void RTC1_IRQHandler(void)
+CORE_ISR_RAMFUNC void RTC1_IRQHandler(void)
 {
   NRF_RTC1->EVENTS_OVRFLW = 0;
 
@@ -56,3 +56,12 @@ static void __halt() {
 }
 void svcHook(void)    __attribute__ ((weak, alias("__halt")));
 void pendSVHook(void) __attribute__ ((weak, alias("__halt")));
+
+/**
+ * Heap locked hook
+ *
+ * Called by any allocation made after lockHeap(), in builds with the
+ * Dynamic Allocation menu set to "Only in setup()". Default action is
+ * halting, if a replacement returns the allocation goes ahead.
+ */
+void heapLockedHook(void) __attribute__ ((weak, alias("__halt")));
@@ -23,11 +23,122 @@
 extern "C" {
 #endif
 
+static const char digitPairs[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+extern char* ultostr( unsigned long value, char *end, int radix, int uppercase )
+{
+  char *sp = end;
+  char alpha = (uppercase ? 'A' : 'a') - 10;
+
+  if (radix == 10)
+  {
+    // two digits per step, halving the divisions
+    while (value >= 100)
+    {
+#if defined(__ARM_ARCH_6M__)
+      // the Cortex-M0 has no 32x32->64 multiply, the reciprocal below
+      // would be an __aeabi_lmul call, no cheaper than the divide
+      unsigned long q = value / 100;
+#else
+      // v / 100 as a multiply by its reciprocal
+      unsigned long q = (unsigned long)(((unsigned long long)value * 0x51EB851FUL) >> 37);
+#endif
+      const char *pair = &digitPairs[(value - q * 100) * 2];
+
+      *--sp = pair[1];
+      *--sp = pair[0];
+      value = q;
+    }
+
+    if (value >= 10)
+    {
+      *--sp = digitPairs[value * 2 + 1];
+      *--sp = digitPairs[value * 2];
+    }
+    else
+    {
+      *--sp = value + '0';
+    }
+  }
+  else if ((radix & (radix - 1)) == 0)
+  {
+    // 2, 4, 8, 16 and 32 by shifting
+    int shift = __builtin_ctz(radix);
+    unsigned long mask = radix - 1;
+
+    do
+    {
+      unsigned long i = value & mask;
+
+      *--sp = i < 10 ? i + '0' : i + alpha;
+      value >>= shift;
+    } while (value);
+  }
+  else
+  {
+    do
+    {
+      unsigned long i = value % radix;
+
+      value = value / radix;
+      *--sp = i < 10 ? i + '0' : i + alpha;
+    } while (value);
+  }
+
+  return sp;
+}
+
+extern char* ulltostr( unsigned long long value, char *end, int radix, int uppercase )
+{
+  char *sp = end;
+
+  if (radix == 10)
+  {
+    // 9 digit groups, so only the top one needs more than 32 bits
+    while (value > 0xFFFFFFFFULL)
+    {
+      unsigned long long q = value / 1000000000ULL;
+      char *group = ultostr((unsigned long)(value - q * 1000000000ULL), sp, 10, uppercase);
+
+      while (group > sp - 9)
+      {
+        *--group = '0';
+      }
+
+      sp = group;
+      value = q;
+    }
+  }
+  else
+  {
+    char alpha = (uppercase ? 'A' : 'a') - 10;
+
+    while (value > 0xFFFFFFFFULL)
+    {
+      unsigned long i = value % radix;
+
+      value = value / radix;
+      *--sp = i < 10 ? i + '0' : i + alpha;
+    }
+  }
+
+  return ultostr((unsigned long)value, sp, radix, uppercase);
+}
+
 extern char* ltoa( long value, char *string, int radix )
 {
   char tmp[33];
-  char *tp = tmp;
-  long i;
+  char *tp;
   unsigned long v;
   int sign;
   char *sp;
@@ -52,22 +163,14 @@ extern char* ltoa( long value, char *string, int radix )
     v = (unsigned long)value;
   }
 
-  while (v || tp == tmp)
-  {
-    i = v % radix;
-    v = v / radix;
-    if (i < 10)
-      *tp++ = i+'0';
-    else
-      *tp++ = i + 'a' - 10;
-  }
+  tp = ultostr(v, &tmp[sizeof(tmp)], radix, 0);
 
   sp = string;
 
   if (sign)
     *sp++ = '-';
-  while (tp > tmp)
-    *sp++ = *--tp;
+  memcpy(sp, tp, &tmp[sizeof(tmp)] - tp);
+  sp += &tmp[sizeof(tmp)] - tp;
   *sp = 0;
 
   return string;
@@ -76,10 +179,7 @@ extern char* ltoa( long value, char *string, int radix )
 extern char* ultoa( unsigned long value, char *string, int radix )
 {
   char tmp[33];
-  char *tp = tmp;
-  long i;
-  unsigned long v = value;
-  char *sp;
+  char *tp;
 
   if ( string == NULL )
   {
@@ -91,22 +191,10 @@ extern char* ultoa( unsigned long value, char *string, int radix )
     return 0;
   }
 
-  while (v || tp == tmp)
-  {
-    i = v % radix;
-    v = v / radix;
-    if (i < 10)
-      *tp++ = i+'0';
-    else
-      *tp++ = i + 'a' - 10;
-  }
-
-  sp = string;
+  tp = ultostr(value, &tmp[sizeof(tmp)], radix, 0);
 
-
-  while (tp > tmp)
-    *sp++ = *--tp;
-  *sp = 0;
+  memcpy(string, tp, &tmp[sizeof(tmp)] - tp);
+  string[&tmp[sizeof(tmp)] - tp] = 0;
 
   return string;
 }
@@ -25,6 +25,11 @@ extern "C"{
 extern char* ltoa( long value, char *string, int radix ) ;
 extern char* ultoa( unsigned long value, char *string, int radix ) ;
 
+// Writes the digits of value backwards so that the last one lands just
+// before end, without a terminating zero. Returns the first digit.
+extern char* ultostr( unsigned long value, char *end, int radix, int uppercase ) ;
+extern char* ulltostr( unsigned long long value, char *end, int radix, int uppercase ) ;
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -26,6 +26,8 @@ void initVariant() { }
  */
 int main( void )
 {
+  paintStack();
+
   init();
 
   initVariant();
@@ -34,6 +36,10 @@ int main( void )
 
   setup();
 
+#ifdef HEAP_LOCK
+  lockHeap();
+#endif
+
   for (;;)
   {
     loop();
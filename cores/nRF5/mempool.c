@@ -0,0 +1,146 @@
+/*
+  Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <nrf.h>
+
+#include "mempool.h"
+
+#define MEMPOOL_OFFSET_32   (MEMPOOL_BLOCKS_16 * 16)
+#define MEMPOOL_OFFSET_64   (MEMPOOL_OFFSET_32 + MEMPOOL_BLOCKS_32 * 32)
+#define MEMPOOL_OFFSET_128  (MEMPOOL_OFFSET_64 + MEMPOOL_BLOCKS_64 * 64)
+#define MEMPOOL_ARENA_SIZE  (MEMPOOL_OFFSET_128 + MEMPOOL_BLOCKS_128 * 128)
+
+typedef struct FreeBlock
+{
+  struct FreeBlock *next;
+} FreeBlock;
+
+// block sizes are multiples of 8, so every block is aligned for any type
+// (one byte when the pool is left out, no zero length array)
+static uint8_t arena[MEMPOOL_ARENA_SIZE ? MEMPOOL_ARENA_SIZE : 1] __attribute__ ((aligned (8)));
+
+static uint8_t * const classBase[MEMPOOL_CLASSES] = { arena, arena + MEMPOOL_OFFSET_32, arena + MEMPOOL_OFFSET_64, arena + MEMPOOL_OFFSET_128 };
+static const uint16_t classBlockSize[MEMPOOL_CLASSES] = { 16, 32, 64, 128 };
+static const uint16_t classBlocks[MEMPOOL_CLASSES] = { MEMPOOL_BLOCKS_16, MEMPOOL_BLOCKS_32, MEMPOOL_BLOCKS_64, MEMPOOL_BLOCKS_128 };
+
+static FreeBlock *freeList[MEMPOOL_CLASSES];
+// blocks never handed out yet are taken in order, no setup pass needed
+static uint16_t carved[MEMPOOL_CLASSES];
+static uint16_t used[MEMPOOL_CLASSES];
+static uint16_t peak[MEMPOOL_CLASSES];
+static uint32_t spills;
+static uint32_t misses;
+
+static void *take(int c)
+{
+  void *block;
+
+  if (freeList[c]) {
+    block = freeList[c];
+    freeList[c] = freeList[c]->next;
+  } else if (carved[c] < classBlocks[c]) {
+    block = classBase[c] + carved[c] * classBlockSize[c];
+    carved[c]++;
+  } else {
+    return NULL;
+  }
+
+  if (++used[c] > peak[c]) {
+    peak[c] = used[c];
+  }
+
+  return block;
+}
+
+void *mempoolAlloc(size_t size)
+{
+  void *block = NULL;
+  bool fitting = true;
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  for (int c = 0; c < MEMPOOL_CLASSES && block == NULL; c++) {
+    if (size > classBlockSize[c]) {
+      continue;
+    }
+
+    block = take(c);
+
+    if (block && !fitting) {
+      spills++;
+    }
+
+    fitting = false;
+  }
+
+  // larger requests are malloc()'s by design, only an exhausted pool misses
+  if (block == NULL && size <= MEMPOOL_MAX_BLOCK) {
+    misses++;
+  }
+
+  __set_PRIMASK(primask);
+
+  return block;
+}
+
+bool mempoolOwns(const void *ptr)
+{
+  return (const uint8_t *)ptr >= arena && (const uint8_t *)ptr < arena + MEMPOOL_ARENA_SIZE;
+}
+
+void mempoolFree(void *ptr)
+{
+  if (!mempoolOwns(ptr)) {
+    return;
+  }
+
+  int c = MEMPOOL_CLASSES - 1;
+
+  while ((uint8_t *)ptr < classBase[c]) {
+    c--;
+  }
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  FreeBlock *block = (FreeBlock *)ptr;
+  block->next = freeList[c];
+  freeList[c] = block;
+  used[c]--;
+
+  __set_PRIMASK(primask);
+}
+
+void mempoolGetStats(MempoolStats *stats)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  for (int c = 0; c < MEMPOOL_CLASSES; c++) {
+    stats->classes[c].blockSize = classBlockSize[c];
+    stats->classes[c].blocks = classBlocks[c];
+    stats->classes[c].used = used[c];
+    stats->classes[c].peak = peak[c];
+  }
+
+  stats->spills = spills;
+  stats->misses = misses;
+
+  __set_PRIMASK(primask);
+}
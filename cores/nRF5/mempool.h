@@ -0,0 +1,93 @@
+/*
+  Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Bytes of the static arena the blocks are carved from, set with
+// -DMEMPOOL_SIZE=... (0 leaves the pool out). The nRF51 has 16 or 32 KB of
+// RAM against the 64 KB of an nRF52832, so it gets half the arena.
+#ifndef MEMPOOL_SIZE
+#ifdef NRF51
+#define MEMPOOL_SIZE 512
+#else
+#define MEMPOOL_SIZE 1024
+#endif
+#endif
+
+// Blocks per size class, a quarter of the arena each unless set one by one.
+// A class set to 0 is left out.
+#ifndef MEMPOOL_BLOCKS_16
+#define MEMPOOL_BLOCKS_16 (MEMPOOL_SIZE / 4 / 16)
+#endif
+#ifndef MEMPOOL_BLOCKS_32
+#define MEMPOOL_BLOCKS_32 (MEMPOOL_SIZE / 4 / 32)
+#endif
+#ifndef MEMPOOL_BLOCKS_64
+#define MEMPOOL_BLOCKS_64 (MEMPOOL_SIZE / 4 / 64)
+#endif
+#ifndef MEMPOOL_BLOCKS_128
+#define MEMPOOL_BLOCKS_128 (MEMPOOL_SIZE / 4 / 128)
+#endif
+
+#define MEMPOOL_CLASSES 4
+#define MEMPOOL_MAX_BLOCK 128
+
+typedef struct
+{
+  uint16_t blockSize;
+  uint16_t blocks;
+  uint16_t used;
+  uint16_t peak;      // most blocks in use at once
+} MempoolClassStats;
+
+typedef struct
+{
+  MempoolClassStats classes[MEMPOOL_CLASSES];
+  uint32_t spills;    // served by a larger class, the fitting one was empty
+  uint32_t misses;    // fitted a class but every block large enough was taken
+} MempoolStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * \brief Takes a block from the smallest size class that fits size and has
+ * one free, in constant time. Returns NULL if there is none or size is over
+ * MEMPOOL_MAX_BLOCK, the caller falls back to malloc() (operator new does).
+ * Safe to call from interrupts, unlike malloc().
+ */
+void *mempoolAlloc(size_t size);
+
+/*
+ * \brief Returns a block taken with mempoolAlloc(), in constant time. Safe to
+ * call from interrupts. Pointers the pool doesn't own are ignored.
+ */
+void mempoolFree(void *ptr);
+
+bool mempoolOwns(const void *ptr);
+
+void mempoolGetStats(MempoolStats *stats);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
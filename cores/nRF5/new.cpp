@@ -18,18 +18,36 @@
 
 #include <stdlib.h>
 
+#include "mempool.h"
+#include "ram_usage.h"
+
+// Small objects come from the fixed block pool, which doesn't fragment the
+// heap; the rest, or anything the pool is out of, from malloc().
+
+static inline void *pooled(void *ptr) {
+#ifdef HEAP_LOCK
+  // pool blocks count as allocations too, malloc() checks for itself
+  if (ptr && heapLocked()) heapLockedHook();
+#endif
+  return ptr;
+}
+
 void *operator new(size_t size) {
-  return malloc(size);
+  void *ptr = pooled(mempoolAlloc(size));
+  return ptr ? ptr : malloc(size);
 }
 
 void *operator new[](size_t size) {
-  return malloc(size);
+  void *ptr = pooled(mempoolAlloc(size));
+  return ptr ? ptr : malloc(size);
 }
 
 void operator delete(void * ptr) {
-  free(ptr);
+  if (mempoolOwns(ptr)) mempoolFree(ptr);
+  else free(ptr);
 }
 
 void operator delete[](void * ptr) {
-  free(ptr);
+  if (mempoolOwns(ptr)) mempoolFree(ptr);
+  else free(ptr);
 }
@@ -0,0 +1,198 @@
+/*
+  Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include <errno.h>
+#include <malloc.h>
+
+#include <nrf.h>
+
+#include "ram_usage.h"
+
+#define STACK_PAINT 0xa5a5a5a5
+
+// words just below the stack pointer left alone while painting
+#define STACK_PAINT_MARGIN 16
+
+// from the linker script
+extern uint32_t __HeapBase[];
+extern uint32_t __StackLimit[];
+extern uint32_t __StackTop[];
+
+// nano malloc's free list, sorted by address
+typedef struct FreeChunk
+{
+  long size;
+  struct FreeChunk *next;
+} FreeChunk;
+
+extern FreeChunk *__malloc_free_list __attribute__((weak));
+
+static uint8_t *heapTop;
+static uint8_t *heapPeak;
+
+// Replaces the libnosys one, which never fails: the heap stops at the stack
+// region instead of silently growing into the stack.
+void *_sbrk(int incr)
+{
+  if (heapTop == NULL) {
+    heapTop = (uint8_t *)__HeapBase;
+    heapPeak = heapTop;
+  }
+
+  if (incr > 0 && incr > (uint8_t *)__StackLimit - heapTop) {
+    errno = ENOMEM;
+    return (void *)-1;
+  }
+
+  uint8_t *previous = heapTop;
+
+  heapTop += incr;
+
+  if (heapTop > heapPeak) {
+    heapPeak = heapTop;
+  }
+
+  return previous;
+}
+
+static uint32_t *heapEnd(void)
+{
+  uint8_t *top = heapTop ? heapTop : (uint8_t *)__HeapBase;
+
+  return (uint32_t *)(((uint32_t)top + 3) & ~3);
+}
+
+void paintStack(void)
+{
+  uint32_t *end = (uint32_t *)(__get_MSP() & ~3) - STACK_PAINT_MARGIN;
+
+  for (uint32_t *p = heapEnd(); p < end; p++) {
+    *p = STACK_PAINT;
+  }
+}
+
+uint32_t stackHighWaterMark(void)
+{
+  uint32_t *p = heapEnd();
+
+  // the heap may have grown over part of the paint since, that part was
+  // never reached by the stack
+  while (p < __StackTop && *p == STACK_PAINT) {
+    p++;
+  }
+
+  return (uint32_t)__StackTop - (uint32_t)p;
+}
+
+uint32_t stackSize(void)
+{
+  return (uint32_t)__StackTop - (uint32_t)__StackLimit;
+}
+
+void getHeapStats(HeapStats *stats)
+{
+  struct mallinfo info = mallinfo();
+  uint8_t *base = (uint8_t *)__HeapBase;
+  uint8_t *top = heapTop ? heapTop : base;
+  uint32_t largest = 0;
+
+  // malloc() isn't used from interrupts, nothing changes the list meanwhile
+  if (&__malloc_free_list) {
+    for (FreeChunk *chunk = __malloc_free_list; chunk; chunk = chunk->next) {
+      if ((uint32_t)chunk->size > largest) {
+        largest = chunk->size;
+      }
+    }
+  }
+
+  // a chunk gives up its size header to the allocation
+  if (largest > sizeof(long)) {
+    largest -= sizeof(long);
+  }
+
+  // a fresh chunk from _sbrk() also needs its header and 8 byte alignment
+  uint32_t room = (uint8_t *)__StackLimit - top;
+
+  if (room > 2 * sizeof(long) && room - 2 * sizeof(long) > largest) {
+    largest = room - 2 * sizeof(long);
+  }
+
+  stats->size = (uint8_t *)__StackLimit - base;
+  stats->used = info.uordblks;
+  stats->peak = (heapPeak ? heapPeak : base) - base;
+  stats->free = stats->size - stats->used;
+  stats->largestFree = largest;
+}
+
+#ifdef HEAP_LOCK
+static volatile bool locked;
+
+void lockHeap(void)
+{
+  locked = true;
+}
+
+bool heapLocked(void)
+{
+  return locked;
+}
+
+// The "Only in setup()" link wraps newlib's allocator entry points with
+// these, so calls from inside the C library are caught as well. The first
+// argument is newlib's struct _reent pointer, passed through untouched.
+void *__real__malloc_r(void *reent, size_t size);
+void *__real__calloc_r(void *reent, size_t count, size_t size);
+void *__real__realloc_r(void *reent, void *ptr, size_t size);
+void *__real__memalign_r(void *reent, size_t align, size_t size);
+
+void *__wrap__malloc_r(void *reent, size_t size)
+{
+  if (locked) {
+    heapLockedHook();
+  }
+
+  return __real__malloc_r(reent, size);
+}
+
+void *__wrap__calloc_r(void *reent, size_t count, size_t size)
+{
+  if (locked) {
+    heapLockedHook();
+  }
+
+  return __real__calloc_r(reent, count, size);
+}
+
+void *__wrap__realloc_r(void *reent, void *ptr, size_t size)
+{
+  if (locked) {
+    heapLockedHook();
+  }
+
+  return __real__realloc_r(reent, ptr, size);
+}
+
+void *__wrap__memalign_r(void *reent, size_t align, size_t size)
+{
+  if (locked) {
+    heapLockedHook();
+  }
+
+  return __real__memalign_r(reent, align, size);
+}
+#endif
@@ -0,0 +1,76 @@
+/*
+  Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The heap grows up from the end of .bss towards the stack region at the
+// top of RAM. The startup file only reserves __HEAP_SIZE/__STACK_SIZE bytes
+// of it at link time (the Stack Size and Heap Size menus set them), the
+// heap may use all the RAM below the stack region.
+typedef struct
+{
+  uint32_t size;         // bytes from the heap start to the stack region
+  uint32_t used;         // in allocated blocks, headers included
+  uint32_t peak;         // highest the heap top has been, from the heap start
+  uint32_t free;         // size - used, free blocks plus room left to grow
+  uint32_t largestFree;  // largest single malloc() that would succeed
+} HeapStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * \brief Fills the RAM between the heap and the stack pointer with a known
+ * pattern. Called first thing in main(), the sketch doesn't need to.
+ */
+void paintStack(void);
+
+/*
+ * \brief Most bytes of stack used since reset, interrupts included (they
+ * share the one stack). More than stackSize() means the stack has run past
+ * its reserved region into the free RAM below it.
+ */
+uint32_t stackHighWaterMark(void);
+
+/*
+ * \brief Bytes reserved for the stack at link time.
+ */
+uint32_t stackSize(void);
+
+void getHeapStats(HeapStats *stats);
+
+#ifdef HEAP_LOCK
+/*
+ * \brief From now on every malloc(), calloc(), realloc() and operator new
+ * calls heapLockedHook() first, which halts unless the sketch overrides it.
+ * Built with the Dynamic Allocation menu set to "Only in setup()", which
+ * defines HEAP_LOCK, and main() calls it as soon as setup() returns.
+ */
+void lockHeap(void);
+bool heapLocked(void);
+
+void heapLockedHook(void);
+#endif
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
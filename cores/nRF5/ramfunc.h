@@ -0,0 +1,40 @@
+/*
+  Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+// Runs the function from RAM: the startup code copies the .ramfunc section
+// along with .data, so it costs its size in both flash and RAM. Not
+// inlined, an inlined copy would run from flash. long_call lets callers in
+// flash reach it, RAM is too far for a BL.
+//
+// On the nRF51 that saves the flash wait states. On the nRF52 the code is
+// fetched from 0x2000xxxx over the System bus, which can be slower than the
+// flash through its cache, so there it is for code that has to run while
+// the flash is busy (NVMC writes and erases) rather than for speed.
+#define RAMFUNC __attribute__ ((section (".ramfunc"), long_call, noinline))
+
+// The core's interrupt handlers (RTC1, GPIOTE, UART and the PWM timer) and
+// what they call run from RAM on the nRF51 when built with
+// -DCORE_ISR_IN_RAM, set by the Interrupt Handlers menu. The nRF52 boards
+// don't have the menu and keep them in flash.
+#if defined(CORE_ISR_IN_RAM) && !defined(NRF52_SERIES)
+#define CORE_ISR_RAMFUNC RAMFUNC
+#else
+#define CORE_ISR_RAMFUNC
+#endif
@@ -270,7 +270,7 @@ void analogWrite( uint32_t ulPin, uint32_t ulValue )
   }
 }
 
-void TIMER1_IRQHandler(void)
+CORE_ISR_RAMFUNC void TIMER1_IRQHandler(void)
 {
   if (NRF_TIMER1->EVENTS_COMPARE[0]) {
     for (int i = 0; i < PWM_COUNT; i++) {
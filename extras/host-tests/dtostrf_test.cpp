@@ -0,0 +1,144 @@
+// Checks the integer digits of fmtdouble() and its callers against
+// snprintf("%.*f") for values at and beyond 2^64, where the 64-bit fast
+// path hands over to the exact large number path, print() included.
+// Negative zero keeps its sign, as with newlib.
+
+#include "host_test.h"
+
+#include <float.h>
+#include <math.h>
+
+class StringPrint : public Print
+{
+  public:
+    StringPrint() : length(0) { text[0] = '\0'; }
+
+    size_t write(uint8_t c)
+    {
+      if (length < sizeof(text) - 1) {
+        text[length++] = c;
+        text[length] = '\0';
+      }
+      return 1;
+    }
+
+    using Print::write;
+
+    char text[400];
+    size_t length;
+};
+
+static uint64_t state = 88172645463325252ULL;
+
+static uint64_t next()
+{
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+static void checkValue(double value, int prec)
+{
+  char expected[400], actual[FMTDOUBLE_LARGE_BUFFER_SIZE(FMTDOUBLE_MAX_PREC)];
+
+  snprintf(expected, sizeof(expected), "%.*f", prec, value);
+
+  size_t length = fmtdouble(value, prec, actual);
+  CHECK(strcmp(expected, actual) == 0);
+  CHECK(length == strlen(expected));
+  CHECK(fmtdoublelength(value, prec) == length);
+
+  if (strcmp(expected, actual) != 0) {
+    printf("  %s vs %s\n", expected, actual);
+  }
+
+  dtostrf(value, 0, prec, actual);
+  CHECK(strcmp(expected, actual) == 0);
+
+  CHECK(String(value, prec) == expected);
+
+  StringPrint p;
+  p.printf("%.*f", prec, value);
+  CHECK(strcmp(expected, p.text) == 0);
+
+  StringPrint q;
+  q.print(value, prec);
+  CHECK(strcmp(expected, q.text) == 0);
+}
+
+static void checkLarge()
+{
+  static const double edges[] = {
+    18446744073709551616.0, 18446744073709555712.0, 1e20, 1e22, 1e23,
+    4294967296.0 * 4294967296.0 * 4294967296.0, 1.2345678901234567e100,
+    1e300, DBL_MAX
+  };
+
+  for (unsigned i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+    checkValue(edges[i], 0);
+    checkValue(edges[i], 2);
+    checkValue(-edges[i], 6);
+  }
+
+  // every exponent from 2^64 to the top, random mantissas
+  for (int exponent = 64; exponent < 1024; exponent++) {
+    for (int n = 0; n < 8; n++) {
+      double mantissa = 1.0 + (double)(next() >> 12) / 4503599627370496.0;
+      checkValue(ldexp(mantissa, exponent), n % 3);
+    }
+  }
+
+  // just below the large path
+  checkValue(18446744073709549568.0, 2);
+}
+
+static void checkSigns()
+{
+  checkValue(-0.0, 0);
+  checkValue(-0.0, 2);
+  checkValue(0.0, 2);
+  checkValue(-1e-9, 3);
+}
+
+static void checkStrings()
+{
+  char expected[400];
+
+  snprintf(expected, sizeof(expected), "x=%.2f!", 1e30);
+
+  String s("x=");
+  s += 1e30;
+  s += '!';
+  CHECK(s == expected);
+
+  CHECK(String::join("x=", 1e30, '!') == expected);
+  CHECK(String::join("x=", 1e30f, '!') == String("x=") + String(1e30f) + "!");
+  CHECK(String::join(1.5, ' ', -2e25) == "1.50 -20000000000000001811939328.00");
+
+  StringPrint p;
+  p.print(1e30);
+  p.print(' ');
+  p.print(-1e30, 0);
+  p.print(' ');
+  p.print(18446744073709549568.0, 0);
+  CHECK(strcmp(p.text, "1000000000000000019884624838656.00 -1000000000000000019884624838656 18446744073709549568") == 0);
+
+  // decimals past the 19 fmtdouble() prints are zeros, whatever the path
+  StringPrint z;
+  z.print(0.5, 21);
+  z.print(' ');
+  z.print(1e20, 21);
+  z.print(' ');
+  z.print(-INFINITY, 21);
+  CHECK(strcmp(z.text, "0.500000000000000000000 100000000000000000000.000000000000000000000 -inf") == 0);
+}
+
+int main()
+{
+  checkLarge();
+  checkSigns();
+  checkStrings();
+
+  return hostResult();
+}
@@ -0,0 +1,96 @@
+// Checks printf("%e") and printf("%g") of Print, through fmtexponent() and
+// fmtgeneral(), against snprintf() over the whole range of a double. The
+// scaling by powers of ten is off by a few bits at the end, so the values
+// only get up to 10 significant digits, where that doesn't show.
+
+#include "host_test.h"
+
+#include <float.h>
+#include <math.h>
+
+class StringPrint : public Print
+{
+  public:
+    StringPrint() : length(0) { text[0] = '\0'; }
+
+    size_t write(uint8_t c)
+    {
+      if (length < sizeof(text) - 1) {
+        text[length++] = c;
+        text[length] = '\0';
+      }
+      return 1;
+    }
+
+    using Print::write;
+
+    char text[64];
+    size_t length;
+};
+
+static uint64_t state = 88172645463325252ULL;
+
+static uint64_t next()
+{
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+static void checkFormat(const char *format, double value, int prec)
+{
+  char expected[64];
+  StringPrint p;
+
+  snprintf(expected, sizeof(expected), format, prec, value);
+  p.printf(format, prec, value);
+
+  CHECK(strcmp(expected, p.text) == 0);
+
+  if (strcmp(expected, p.text) != 0) {
+    printf("  %s of %.17g: %s vs %s\n", format, value, expected, p.text);
+  }
+}
+
+static void checkValue(double value)
+{
+  for (int prec = 0; prec <= 9; prec++) {
+    checkFormat("%.*e", value, prec);
+    checkFormat("%.*g", value, prec);
+  }
+
+  checkFormat("%.*E", -value, 3);
+  checkFormat("%.*G", -value, 3);
+  checkFormat("%#.*g", value, 4);
+  checkFormat("%+12.*e", value, 2);
+  checkFormat("%-12.*g|", value, 2);
+  checkFormat("%012.*e", -value, 2);
+}
+
+int main()
+{
+  static const double edges[] = {
+    0.0, 1.0, 9.5, 9.9999999, 10.0, 0.0001, 0.00009999, 123456.0, 999999.5,
+    1e-5, 1e100, 1e-100, 5e-324, 2.2250738585072014e-308, DBL_MAX, 1e22, 1e23
+  };
+
+  for (unsigned i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+    checkValue(edges[i]);
+  }
+
+  // random mantissas over every binary exponent
+  for (int exponent = -1074; exponent < 1024; exponent++) {
+    double mantissa = 1.0 + (double)(next() >> 12) / 4503599627370496.0;
+    checkValue(ldexp(mantissa, exponent));
+  }
+
+  char expected[64];
+  StringPrint p;
+
+  p.printf("%e %G %g", NAN, -INFINITY, INFINITY);
+  snprintf(expected, sizeof(expected), "%e %G %g", NAN, -INFINITY, INFINITY);
+  CHECK(strcmp(expected, p.text) == 0);
+
+  return hostResult();
+}
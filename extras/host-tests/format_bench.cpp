@@ -0,0 +1,258 @@
+// Checks ultoa()/ltoa() and print(value, base) against snprintf() for every
+// base the core has a fast path for, then times them against snprintf() and
+// a per digit divide loop. Values stay within 32 bits, as on the nRF5.
+// Doubles with 2 decimals are timed through fmtdouble() and print() against
+// what the core used before: dtostrf() on top of sprintf("%*.*f") and the
+// printFloat() loop that printed one decimal at a time.
+//
+// The host timings only compare the algorithms, the FormatBenchmark sketch
+// of the nRF5Benchmarks library measures the cycles (and shows how to get
+// the code size) on the chip.
+
+#include "host_test.h"
+
+#include <ctype.h>
+#include <time.h>
+
+class StringPrint : public Print
+{
+  public:
+    StringPrint() : length(0) { text[0] = '\0'; }
+
+    size_t write(uint8_t c)
+    {
+      if (length < sizeof(text) - 1) {
+        text[length++] = c;
+        text[length] = '\0';
+      }
+      return 1;
+    }
+
+    using Print::write;
+
+    char text[40];
+    size_t length;
+};
+
+static uint32_t state = 2463534242UL;
+
+static uint32_t next()
+{
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  // every digit count shows up
+  return state >> (state % 32);
+}
+
+static void reference(unsigned long value, int base, char *out)
+{
+  if (base == 10) sprintf(out, "%lu", value);
+  else if (base == 16) sprintf(out, "%lx", value);
+  else if (base == 8) sprintf(out, "%lo", value);
+  else {
+    char tmp[65];
+    char *p = &tmp[64];
+    *p = '\0';
+    do {
+      *--p = '0' + (value & 1);
+      value >>= 1;
+    } while (value);
+    strcpy(out, p);
+  }
+}
+
+static void check()
+{
+  static const int bases[] = { 2, 8, 10, 16 };
+  static const uint32_t edges[] = { 0, 1, 9, 10, 99, 100, 101, 999, 1000, 65535, 65536, 99999999, 100000000, 4294967295UL };
+
+  for (int n = 0; n < 100000 + (int)(sizeof(edges) / sizeof(edges[0])); n++) {
+    uint32_t value = n < (int)(sizeof(edges) / sizeof(edges[0])) ? edges[n] : next();
+
+    for (unsigned b = 0; b < sizeof(bases) / sizeof(bases[0]); b++) {
+      char expected[65], actual[65];
+
+      reference(value, bases[b], expected);
+      ultoa(value, actual, bases[b]);
+      CHECK(strcmp(expected, actual) == 0);
+
+      StringPrint p;
+      p.print((unsigned long)value, bases[b]);
+      // print() writes hex digits in upper case, as on the AVR
+      for (char *c = expected; *c; c++) *c = toupper(*c);
+      CHECK(strcmp(expected, p.text) == 0);
+    }
+
+    char expected[24], actual[24];
+    long negative = -(long)(value >> 1);
+
+    sprintf(expected, "%ld", negative);
+    ltoa(negative, actual, 10);
+    CHECK(strcmp(expected, actual) == 0);
+  }
+}
+
+static double now()
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static char * divideLoop(unsigned long value, char *end)
+{
+  do {
+    *--end = '0' + value % 10;
+    value /= 10;
+  } while (value);
+
+  return end;
+}
+
+// the core's dtostrf() and printFloat() before fmtdouble()
+static char * oldDtostrf(double val, signed char width, unsigned char prec, char *sout)
+{
+  char fmt[20];
+  sprintf(fmt, "%%%d.%df", width, prec);
+  sprintf(sout, fmt, val);
+  return sout;
+}
+
+static size_t oldPrintFloat(Print &out, double number, uint8_t digits)
+{
+  size_t n = 0;
+
+  if (number < 0.0) {
+    n += out.print('-');
+    number = -number;
+  }
+
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; ++i)
+    rounding /= 10.0;
+
+  number += rounding;
+
+  unsigned long int_part = (unsigned long)number;
+  double remainder = number - (double)int_part;
+  n += out.print(int_part);
+
+  if (digits > 0) {
+    n += out.print(".");
+  }
+
+  while (digits-- > 0) {
+    remainder *= 10.0;
+    int toPrint = int(remainder);
+    n += out.print(toPrint);
+    remainder -= toPrint;
+  }
+
+  return n;
+}
+
+static volatile char sink;
+
+static const int VALUES = 4096;
+static const int ROUNDS = 256;
+static unsigned long values[VALUES];
+static double doubles[VALUES];
+
+static void report(const char *name, double start)
+{
+  printf("  %-18s %6.1f ns per number\n", name, (now() - start) / ((double)VALUES * ROUNDS));
+}
+
+static void bench()
+{
+  char buffer[66];
+
+  for (int i = 0; i < VALUES; i++) {
+    values[i] = next();
+  }
+
+  static const int bases[] = { 10, 16, 8, 2 };
+  static const char * const names[] = { "ultoa base 10", "ultoa base 16", "ultoa base 8", "ultoa base 2" };
+
+  for (int b = 0; b < 4; b++) {
+    double start = now();
+    for (int r = 0; r < ROUNDS; r++) {
+      for (int i = 0; i < VALUES; i++) {
+        ultoa(values[i], buffer, bases[b]);
+        sink = buffer[0];
+      }
+    }
+    report(names[b], start);
+  }
+
+  double start = now();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      sink = *divideLoop(values[i], &buffer[sizeof(buffer)]);
+    }
+  }
+  report("divide loop", start);
+
+  start = now();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      snprintf(buffer, sizeof(buffer), "%lu", values[i]);
+      sink = buffer[0];
+    }
+  }
+  report("snprintf %lu", start);
+
+  // up to 7 integer digits, within the range of the old printFloat()
+  for (int i = 0; i < VALUES; i++) {
+    doubles[i] = (double)(long)(values[i] >> 2) / ((i & 1) ? -1000.0 : 1000.0);
+  }
+
+  StringPrint p;
+
+  start = now();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      oldDtostrf(doubles[i], 0, 2, buffer);
+      sink = buffer[0];
+    }
+  }
+  report("sprintf dtostrf", start);
+
+  start = now();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      fmtdouble(doubles[i], 2, buffer);
+      sink = buffer[0];
+    }
+  }
+  report("fmtdouble", start);
+
+  start = now();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      p.length = 0;
+      oldPrintFloat(p, doubles[i], 2);
+      sink = p.text[0];
+    }
+  }
+  report("old printFloat", start);
+
+  start = now();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      p.length = 0;
+      p.print(doubles[i], 2);
+      sink = p.text[0];
+    }
+  }
+  report("print double", start);
+}
+
+int main()
+{
+  check();
+  bench();
+
+  return hostResult();
+}
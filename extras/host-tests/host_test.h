@@ -0,0 +1,88 @@
+// Shared by the host tests: checks that count failures instead of stopping,
+// and a Stream served from memory.
+
+#ifndef host_test_h
+#define host_test_h
+
+#include <Arduino.h>
+
+#include <stdio.h>
+
+// what micros() and millis() return
+extern uint32_t hostMicros;
+
+// calls to malloc() and realloc() so far
+extern uint32_t hostAllocations;
+
+static int hostFailures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      hostFailures++; \
+    } \
+  } while (0)
+
+// exit status for main()
+static inline int hostResult(void)
+{
+  if (hostFailures) {
+    printf("%d checks failed\n", hostFailures);
+  }
+
+  return hostFailures ? 1 : 0;
+}
+
+// Reads from a byte array at most chunk bytes per read(uint8_t *, size_t),
+// so callers see data arrive in pieces. Writes are collected in output.
+class MemoryStream : public Stream
+{
+  public:
+    MemoryStream() : input(NULL), inputLength(0), position(0), chunk(64), outputLength(0) {}
+
+    void feed(const uint8_t *data, size_t length, size_t chunkSize)
+    {
+      input = data;
+      inputLength = length;
+      position = 0;
+      chunk = chunkSize ? chunkSize : 1;
+    }
+
+    int available() { return inputLength - position; }
+    int peek() { return position < inputLength ? input[position] : -1; }
+    int read() { return position < inputLength ? input[position++] : -1; }
+
+    int read(uint8_t *buffer, size_t length)
+    {
+      size_t n = inputLength - position;
+
+      if (n > length) n = length;
+      if (n > chunk) n = chunk;
+
+      memcpy(buffer, input + position, n);
+      position += n;
+
+      return n;
+    }
+
+    void flush() {}
+
+    size_t write(uint8_t c)
+    {
+      if (outputLength == sizeof(output)) return 0;
+      output[outputLength++] = c;
+      return 1;
+    }
+
+    using Print::write;
+
+    const uint8_t *input;
+    size_t inputLength;
+    size_t position;
+    size_t chunk;
+
+    uint8_t output[4096];
+    size_t outputLength;
+};
+
+#endif
@@ -0,0 +1,81 @@
+#!/bin/sh
+#
+# Host tests and benchmarks for the parts of the core and libraries that
+# don't touch the hardware. The sources below are built with the host
+# compiler against the real nRF5 headers, then every *_test.cpp and
+# *_bench.cpp here (or the ones named) is linked against them and run.
+#
+#   extras/host-tests/run.sh [framing_fuzz_test.cpp ...]
+#
+# Note that long is 64 bits on most hosts, 32 on the nRF5.
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+OUT=${OUT:-${TMPDIR:-/tmp}/nrf5-host-tests}
+SDK=$ROOT/cores/nRF5/SDK/components
+
+SOURCES="
+  cores/nRF5/WString.cpp
+  cores/nRF5/StringView.cpp
+  cores/nRF5/Print.cpp
+  cores/nRF5/Stream.cpp
+  cores/nRF5/RingBuffer.cpp
+  cores/nRF5/itoa.c
+  cores/nRF5/avr/dtostrf.c
+  libraries/Framing/Framing.cpp
+  libraries/Framing/FramingCrc.cpp
+"
+
+FLAGS="-O2 -g -DNRF5 -DNRF52832_XXAA -DF_CPU=64000000 -DARDUINO=10805
+  -DARDUINO_GENERIC -DARDUINO_ARCH_NRF5
+  -I$ROOT/cores/nRF5 -I$ROOT/variants/Generic -I$SDK/toolchain
+  -I$SDK/toolchain/CMSIS/Include -I$SDK/toolchain/gcc -I$SDK/device
+  -I$SDK/drivers_nrf/delay -I$SDK/softdevice/none/headers
+  -I$ROOT/libraries/Framing -I$HERE"
+
+CC=${CC:-gcc}
+CXX=${CXX:-g++}
+
+mkdir -p "$OUT"
+
+OBJECTS=""
+
+for src in $SOURCES stubs.cpp; do
+  case $src in
+    stubs.cpp) path=$HERE/$src ;;
+    *) path=$ROOT/$src ;;
+  esac
+
+  obj=$OUT/$(basename "$src").o
+
+  case $src in
+    *.c) $CC -std=gnu11 $FLAGS -c "$path" -o "$obj" ;;
+    *) $CXX -std=gnu++11 -fno-rtti -fno-exceptions $FLAGS -c "$path" -o "$obj" ;;
+  esac
+
+  OBJECTS="$OBJECTS $obj"
+done
+
+if [ $# -eq 0 ]; then
+  set -- $(cd "$HERE" && ls *_test.cpp *_bench.cpp 2>/dev/null)
+fi
+
+failed=0
+
+for test in "$@"; do
+  name=$(basename "$test" .cpp)
+
+  echo "== $name"
+
+  $CXX -std=gnu++11 -fno-rtti -fno-exceptions $FLAGS "$HERE/$name.cpp" $OBJECTS \
+    -Wl,--wrap=malloc -Wl,--wrap=realloc -o "$OUT/$name"
+
+  if ! "$OUT/$name"; then
+    echo "FAILED $name"
+    failed=1
+  fi
+done
+
+exit $failed
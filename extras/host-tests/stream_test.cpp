@@ -0,0 +1,30 @@
+// Checks that Stream::readString() keeps every byte, zeros included, however
+// the data is split between reads.
+
+#include "host_test.h"
+
+int main()
+{
+  uint8_t data[200];
+
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = (i % 9 == 4) ? 0 : 'a' + i % 26;
+  }
+
+  static const size_t chunks[] = { 1, 5, 31, 32, 33, 200 };
+
+  for (unsigned c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+    MemoryStream stream;
+
+    // nothing more arrives, no need to wait for it
+    stream.setTimeout(0);
+    stream.feed(data, sizeof(data), chunks[c]);
+
+    String s = stream.readString();
+
+    CHECK(s.length() == sizeof(data));
+    CHECK(memcmp(s.c_str(), data, sizeof(data)) == 0);
+  }
+
+  return hostResult();
+}
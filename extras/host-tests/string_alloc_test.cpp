@@ -0,0 +1,39 @@
+// Counts the heap allocations of String::join() and String::format(): one
+// per expression whatever the number of parts, none when the result fits
+// the String itself, and join() of nothing is an empty String.
+
+#include "host_test.h"
+
+// allocations made by the expression
+#define ALLOCATIONS(expression) (hostAllocations = 0, (void)(expression), hostAllocations)
+
+int main()
+{
+  String name("temperature sensor");
+  const char *unit = " degrees Celsius";
+
+  CHECK(ALLOCATIONS(String::join(name, ':', 21.5, unit)) == 1);
+  CHECK(ALLOCATIONS(String::join(name, ' ', 42, ' ', 42UL, ' ', -7L, ' ', 'x', F(" flash"), StringView("view", 4))) == 1);
+  CHECK(ALLOCATIONS(String::join("large ", 1e300)) == 1);
+  CHECK(ALLOCATIONS(String::format("%s: %d.%02d %s", name.c_str(), 21, 5, unit)) == 1);
+  CHECK(ALLOCATIONS(String::format("%s %e %g", unit, 1e-20, 12345.678)) == 1);
+
+  // short enough for the inline buffer
+  CHECK(ALLOCATIONS(String::join("t=", 21)) == 0);
+  CHECK(ALLOCATIONS(String::format("t=%d", 21)) == 0);
+
+  CHECK(ALLOCATIONS(String::join()) == 0);
+  CHECK(String::join() == "");
+  CHECK(String::join().length() == 0);
+  CHECK(String::join().c_str() != NULL);
+
+  CHECK(String::join(name, ':', 21.5, unit) == "temperature sensor:21.50 degrees Celsius");
+  CHECK(String::format("%s: %d.%02d%s", name.c_str(), 21, 5, unit) == "temperature sensor: 21.05 degrees Celsius");
+
+  // what join() saves: the same with + grows the result piece by piece
+  uint32_t chained = ALLOCATIONS(name + ':' + 21.5 + unit);
+  printf("  join 1 allocation, + chain %u\n", (unsigned)chained);
+  CHECK(chained > 1);
+
+  return hostResult();
+}
@@ -0,0 +1,31 @@
+// Checks that comparing a String with every kind of string resolves to one
+// overload, F() strings included, and compares the characters.
+
+#include "host_test.h"
+
+int main()
+{
+  String s("abc");
+  String other("abd");
+  const char *cstr = "abc";
+  StringView view("abcdef", 3);
+
+  CHECK(s == F("abc"));
+  CHECK(!(s != F("abc")));
+  CHECK(s.equals(F("abc")));
+  CHECK(s != F("ab"));
+  CHECK(!s.equals(F("abcd")));
+
+  CHECK(s == "abc");
+  CHECK(s == cstr);
+  CHECK(s == view);
+  CHECK(s != other);
+  CHECK(s == String(F("abc")));
+  CHECK(s.equals(view));
+  CHECK(s.equals(cstr));
+
+  CHECK(String() == F(""));
+  CHECK(String() != F("a"));
+
+  return hostResult();
+}
@@ -0,0 +1,91 @@
+// Builds a JSON line of 25 fields from about 100 pieces with += and concat(),
+// the way sketches usually put a report together, and counts the heap
+// allocations it takes: the geometric growth of String keeps them to a
+// handful where growing to the exact length took one per piece. Then times
+// it against the same line with its length reserved up front.
+
+#include "host_test.h"
+
+#include <time.h>
+
+static const int FIELDS = 25;
+static const int ROUNDS = 20000;
+
+static const char * const names[] = { "temp", "hum", "pres", "volt", "rssi" };
+
+static double now()
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static void buildLine(String &line)
+{
+  for (int i = 0; i < FIELDS; i++) {
+    line += i ? ",\"" : "{\"";
+    line += names[i % 5];
+    line.concat(i);
+    line += "\":";
+
+    if (i % 2) {
+      line.concat(i * 1000 + 7);
+    } else {
+      line.concat(i * 1.25);
+    }
+  }
+
+  line += '}';
+}
+
+static volatile char sink;
+
+static void report(const char *name, double start)
+{
+  printf("  %-18s %6.1f ns per line\n", name, (now() - start) / ROUNDS);
+}
+
+int main()
+{
+  String line;
+
+  hostAllocations = 0;
+  buildLine(line);
+  uint32_t grown = hostAllocations;
+
+  String reserved;
+
+  hostAllocations = 0;
+  reserved.reserve(line.length());
+  buildLine(reserved);
+  uint32_t once = hostAllocations;
+
+  CHECK(reserved == line);
+  CHECK(line.startsWith("{\"temp0\":0.00,\"hum1\":1007,"));
+  CHECK(line.endsWith("\"temp20\":25.00,\"hum21\":21007,\"pres22\":27.50,\"volt23\":23007,\"rssi24\":30.00}"));
+  CHECK(once == 1);
+  // one and a half times per step from the inline buffer
+  CHECK(grown <= 10);
+
+  printf("  %u characters: += %u allocations, reserved %u\n",
+         (unsigned)line.length(), (unsigned)grown, (unsigned)once);
+
+  double start = now();
+  for (int r = 0; r < ROUNDS; r++) {
+    String s;
+    buildLine(s);
+    sink = s[0];
+  }
+  report("+= and concat", start);
+
+  start = now();
+  for (int r = 0; r < ROUNDS; r++) {
+    String s;
+    s.reserve(line.length());
+    buildLine(s);
+    sink = s[0];
+  }
+  report("reserved first", start);
+
+  return hostResult();
+}
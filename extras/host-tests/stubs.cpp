@@ -0,0 +1,46 @@
+// Stand-ins for the hardware backed functions the host built sources call.
+// Time only moves when a test moves it, see host_test.h. run.sh links with
+// malloc() and realloc() wrapped, so tests can count allocations.
+
+#include "host_test.h"
+
+uint32_t hostMicros = 0;
+uint32_t hostAllocations = 0;
+
+extern "C" {
+
+void *__real_malloc(size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+  hostAllocations++;
+  return __real_malloc(size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+  hostAllocations++;
+  return __real_realloc(ptr, size);
+}
+
+uint32_t millis(void)
+{
+  return hostMicros / 1000;
+}
+
+uint32_t micros(void)
+{
+  return hostMicros;
+}
+
+void delay(uint32_t ms)
+{
+  hostMicros += ms * 1000;
+}
+
+void yield(void)
+{
+}
+
+}
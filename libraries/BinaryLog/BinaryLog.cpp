@@ -0,0 +1,241 @@
+/*
+ * Deferred binary logging for nRF5x
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+extern "C" {
+#include <string.h>
+}
+
+#include "BinaryLog.h"
+
+void BinaryLogRecord::put(const void *bytes, size_t size)
+{
+  if (length + size > sizeof(data))
+  {
+    overflow = true;
+    return;
+  }
+
+  memcpy(&data[length], bytes, size);
+  length += size;
+}
+
+void BinaryLogRecord::putVarint(uint32_t value)
+{
+  uint8_t bytes[5];
+  size_t size = 0;
+
+  while (value >= 0x80)
+  {
+    bytes[size++] = (value & 0x7f) | 0x80;
+    value >>= 7;
+  }
+
+  bytes[size++] = value;
+
+  put(bytes, size);
+}
+
+void BinaryLogRecord::add(unsigned long long value)
+{
+  uint8_t bytes[10];
+  size_t size = 0;
+
+  while (value >= 0x80)
+  {
+    bytes[size++] = (value & 0x7f) | 0x80;
+    value >>= 7;
+  }
+
+  bytes[size++] = value;
+
+  put(bytes, size);
+}
+
+void BinaryLogRecord::add(float value)
+{
+  // little endian IEEE 754, same as the host
+  put(&value, sizeof(value));
+}
+
+void BinaryLogRecord::add(const char *value)
+{
+  // copied, the string may be gone by the time the record is sent
+  size_t size = value ? strlen(value) : 0;
+
+  putVarint(size);
+  put(value, size);
+}
+
+BinaryLogger::BinaryLogger()
+{
+  out = NULL;
+  head = 0;
+  tail = 0;
+  droppedRecords = 0;
+  droppedReported = 0;
+}
+
+void BinaryLogger::begin(Print &out)
+{
+  this->out = &out;
+}
+
+void BinaryLogger::end()
+{
+  flush();
+
+  out = NULL;
+}
+
+void BinaryLogger::commit(const BinaryLogRecord &record)
+{
+  if (record.overflow)
+  {
+    droppedRecords++;
+    return;
+  }
+
+  // COBS framed with a 0x00 at the end, so the decoder finds the next
+  // record after lost or garbled bytes
+  uint8_t frame[FRAMING_COBS_SIZE(BINARY_LOG_MAX_RECORD)];
+  size_t size = framingCobsEncode(record.data, record.length, frame);
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  size_t used = (head + BINARY_LOG_BUFFER_SIZE - tail) % BINARY_LOG_BUFFER_SIZE;
+
+  // one byte always stays free to tell a full ring from an empty one
+  if (used + size >= BINARY_LOG_BUFFER_SIZE)
+  {
+    droppedRecords++;
+  }
+  else
+  {
+    size_t index = head;
+    size_t chunk = BINARY_LOG_BUFFER_SIZE - index;
+
+    if (chunk > size)
+    {
+      chunk = size;
+    }
+
+    memcpy(&buffer[index], frame, chunk);
+    memcpy(&buffer[0], frame + chunk, size - chunk);
+
+    head = (index + size) % BINARY_LOG_BUFFER_SIZE;
+  }
+
+  __set_PRIMASK(primask);
+}
+
+void BinaryLogger::reportDropped()
+{
+  uint32_t count = droppedRecords - droppedReported;
+
+  if (count == 0)
+  {
+    return;
+  }
+
+  BinaryLogRecord record(BINARY_LOG_DROPPED_ID);
+  record.add((unsigned long)count);
+
+  uint32_t before = droppedRecords;
+
+  commit(record);
+
+  // only counted as reported once it made it into the ring
+  if (droppedRecords == before)
+  {
+    droppedReported += count;
+  }
+}
+
+size_t BinaryLogger::send(size_t limit)
+{
+  size_t sent = 0;
+
+  while (sent < limit)
+  {
+    // only this side moves the tail, head may move on meanwhile
+    size_t start = tail;
+    size_t end = head;
+
+    if (start == end)
+    {
+      break;
+    }
+
+    size_t chunk = (end > start ? end : BINARY_LOG_BUFFER_SIZE) - start;
+
+    if (chunk > limit - sent)
+    {
+      chunk = limit - sent;
+    }
+
+    chunk = out->write(&buffer[start], chunk);
+
+    if (chunk == 0)
+    {
+      break;
+    }
+
+    tail = (start + chunk) % BINARY_LOG_BUFFER_SIZE;
+    sent += chunk;
+  }
+
+  return sent;
+}
+
+void BinaryLogger::poll()
+{
+  if (out == NULL)
+  {
+    return;
+  }
+
+  reportDropped();
+
+  int room = out->availableForWrite();
+
+  if (room > 0)
+  {
+    send(room);
+  }
+}
+
+void BinaryLogger::flush()
+{
+  if (out == NULL)
+  {
+    return;
+  }
+
+  reportDropped();
+
+  send(BINARY_LOG_BUFFER_SIZE);
+}
+
+uint32_t BinaryLogger::dropped()
+{
+  return droppedRecords;
+}
+
+BinaryLogger BinaryLog;
@@ -0,0 +1,135 @@
+/*
+ * Deferred binary logging for nRF5x
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef BinaryLog_h
+#define BinaryLog_h
+
+#include <Arduino.h>
+#include <Framing.h>
+
+// RAM ring the records wait in until they are sent
+#ifndef BINARY_LOG_BUFFER_SIZE
+#define BINARY_LOG_BUFFER_SIZE 512
+#endif
+
+// largest record before framing, longer ones are dropped
+#ifndef BINARY_LOG_MAX_RECORD
+#define BINARY_LOG_MAX_RECORD 64
+#endif
+
+// record id reporting how many records were dropped since the last report
+#define BINARY_LOG_DROPPED_ID 0
+
+// Log with a printf format, only the format's address and the arguments
+// are stored. The format string goes to the .log_strings section, which the
+// linker keeps in the ELF but never loads; extras/decode_log.py turns the
+// records back into text. Argument types must match their conversions.
+#define BINARY_LOG(format, ...) do { \
+    static const char __logFormat[] __attribute__((section(".log_strings"), used)) = format; \
+    if (0) binaryLogCheckFormat(format, ##__VA_ARGS__); \
+    BinaryLog.log((uint32_t)__logFormat, ##__VA_ARGS__); \
+  } while (0)
+
+#ifndef LOG
+#define LOG BINARY_LOG
+#endif
+
+static inline void binaryLogCheckFormat(const char *, ...) __attribute__ ((format (printf, 1, 2)));
+static inline void binaryLogCheckFormat(const char *, ...) {}
+
+// One record being encoded: the varint id followed by the arguments.
+// Integers of up to 32 bits are varints of their 32-bit pattern after the
+// usual promotion to int, 64-bit ones varints of all 64 bits; the decoder
+// takes sign and size from the conversion, as printf would. Floating point
+// values are 32-bit floats, strings a varint length plus the bytes.
+class BinaryLogRecord
+{
+  public:
+    BinaryLogRecord(uint32_t id) : length(0), overflow(false) { putVarint(id); }
+
+    void add(bool value) { putVarint(value); }
+    void add(char value) { putVarint((int32_t)value); }
+    void add(signed char value) { putVarint((int32_t)value); }
+    void add(short value) { putVarint((int32_t)value); }
+    void add(int value) { putVarint((int32_t)value); }
+    void add(long value) { putVarint((int32_t)value); }
+    void add(long long value) { add((unsigned long long)value); }
+    void add(unsigned char value) { putVarint(value); }
+    void add(unsigned short value) { putVarint(value); }
+    void add(unsigned int value) { putVarint(value); }
+    void add(unsigned long value) { putVarint(value); }
+    void add(unsigned long long value);
+    void add(float value);
+    void add(double value) { add((float)value); }
+    void add(const char *value);
+    void add(char *value) { add((const char *)value); }
+    void add(const void *value) { putVarint((uint32_t)value); }
+
+    uint8_t data[BINARY_LOG_MAX_RECORD];
+    size_t length;
+    bool overflow;
+
+  private:
+    void put(const void *bytes, size_t size);
+    void putVarint(uint32_t value);
+};
+
+class BinaryLogger
+{
+  public:
+    BinaryLogger();
+
+    void begin(Print &out);
+    void end();
+
+    // Safe from interrupts, the record is dropped if the ring is full.
+    template<typename... Args> void log(uint32_t id, Args... args)
+    {
+      BinaryLogRecord record(id);
+      int unused[] = { 0, (record.add(args), 0)... };
+      (void)unused;
+      commit(record);
+    }
+
+    // Sends queued records, but only as much as the output reports with
+    // availableForWrite() so it never blocks. Call it from loop().
+    void poll();
+    // Sends everything queued, waiting on the output as needed.
+    void flush();
+
+    uint32_t dropped();
+
+  private:
+    void commit(const BinaryLogRecord &record);
+    void reportDropped();
+    size_t send(size_t limit);
+
+    Print *out;
+
+    uint8_t buffer[BINARY_LOG_BUFFER_SIZE];
+    volatile size_t head;
+    volatile size_t tail;
+
+    volatile uint32_t droppedRecords;
+    uint32_t droppedReported;
+};
+
+extern BinaryLogger BinaryLog;
+
+#endif
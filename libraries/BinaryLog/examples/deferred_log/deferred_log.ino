@@ -0,0 +1,35 @@
+// Deferred binary logging
+//
+// LOG() only stores the id of its format string and the raw arguments,
+// the text is put back together on the host:
+//
+//   stty -F /dev/ttyACM0 115200 raw
+//   python3 decode_log.py deferred_log.ino.elf /dev/ttyACM0
+//
+// decode_log.py is in the extras folder of the library, the ELF file is
+// kept in the build folder (Sketch > Export compiled Binary).
+
+#include <BinaryLog.h>
+
+void setup()
+{
+  Serial.begin(115200);
+  BinaryLog.begin(Serial);
+
+  LOG("boot, reset reason 0x%lx", NRF_POWER->RESETREAS);
+}
+
+void loop()
+{
+  static unsigned long count = 0;
+
+  int raw = analogRead(A0);
+  float volts = raw * 3.6 / 1023;
+
+  LOG("sample %lu: raw=%d volts=%.3f", count++, raw, volts);
+
+  // sends what the UART can take without waiting
+  BinaryLog.poll();
+
+  delay(100);
+}
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+#
+# Host side decoder for the BinaryLog library.
+#
+# Reads the format strings from the .log_strings section of the sketch's
+# ELF file and turns the binary records read from a serial port (or a file
+# captured from it) back into text:
+#
+#   stty -F /dev/ttyACM0 115200 raw
+#   decode_log.py sketch.ino.elf /dev/ttyACM0
+#
+# Each record is COBS framed and ends with a 0x00, see framing.py of the
+# Framing library, so decoding picks up again at the next record after
+# lost or garbled bytes. Inside is the varint id of the format string (its
+# address in .log_strings) and the arguments: varints of the 32-bit pattern
+# of integers, or of all 64 bits with ll and j, that the conversion gives
+# sign and size, little endian 32-bit floats for %f/%e/%g and a varint
+# length plus the bytes for %s.
+
+import os
+import re
+import struct
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'Framing', 'extras'))
+
+from framing import Framer
+
+DROPPED_ID = 0
+
+CONVERSION = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|z|j|t)?([diuxXocsfFeEgGp%])')
+
+
+def read_strings(path):
+    with open(path, 'rb') as f:
+        elf = f.read()
+
+    if elf[:4] != b'\x7fELF' or elf[4] != 1:
+        raise ValueError('%s is not a 32-bit ELF file' % path)
+
+    (shoff,) = struct.unpack_from('<I', elf, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x2e)
+
+    def section(index):
+        return struct.unpack_from('<IIIIIIIIII', elf, shoff + index * shentsize)
+
+    names = section(shstrndx)
+
+    for i in range(shnum):
+        name, _, _, addr, offset, size = section(i)[:6]
+        end = elf.index(b'\0', names[4] + name)
+
+        if elf[names[4] + name:end] == b'.log_strings':
+            data = elf[offset:offset + size]
+            strings = {}
+            start = 0
+
+            # every format is its own zero terminated array
+            while start < len(data):
+                stop = data.index(b'\0', start)
+                strings[addr + start] = data[start:stop].decode('utf-8', 'replace')
+                start = stop + 1
+
+            return strings
+
+    raise ValueError('%s has no .log_strings section' % path)
+
+
+class Record:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        value = 0
+        shift = 0
+
+        while True:
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7f) << shift
+            shift += 7
+
+            if not byte & 0x80:
+                return value
+
+    def integer(self, size, signed):
+        bits = {'hh': 8, 'h': 16, 'll': 64, 'j': 64}.get(size, 32)
+        value = self.varint() & ((1 << bits) - 1)
+
+        if signed and value >> (bits - 1):
+            value -= 1 << bits
+
+        return value
+
+    def float(self):
+        (value,) = struct.unpack_from('<f', self.data, self.pos)
+        self.pos += 4
+        return value
+
+    def string(self):
+        length = self.varint()
+        value = self.data[self.pos:self.pos + length]
+        self.pos += length
+        return value.decode('utf-8', 'replace')
+
+
+def format_record(fmt, record):
+    def conversion(match):
+        flags, width, precision, size, kind = match.groups()
+
+        if kind == '%':
+            return '%'
+
+        if width == '*':
+            width = str(record.integer(None, True))
+
+        if precision == '*':
+            precision = str(record.integer(None, True))
+
+        spec = '%' + flags + (width or '') + ('.' + precision if precision is not None else '')
+
+        if kind in 'di':
+            return (spec + 'd') % record.integer(size, True)
+
+        if kind == 'u':
+            return (spec + 'd') % record.integer(size, False)
+
+        if kind in 'xXo':
+            return (spec + kind) % record.integer(size, False)
+
+        if kind == 'p':
+            return '0x%x' % record.integer(None, False)
+
+        if kind == 'c':
+            return (spec + 'c') % chr(record.integer('hh', False))
+
+        if kind == 's':
+            return (spec + 's') % record.string()
+
+        return (spec + kind) % record.float()
+
+    return CONVERSION.sub(conversion, fmt)
+
+
+def decode_record(strings, data):
+    record = Record(data)
+
+    try:
+        id = record.varint()
+
+        if id == DROPPED_ID:
+            return '<%d records dropped>' % record.varint()
+
+        if id in strings:
+            return format_record(strings[id], record)
+
+        return '<unknown id 0x%x>' % id
+    except (IndexError, struct.error, ValueError, TypeError, OverflowError):
+        return '<malformed record %s>' % data.hex()
+
+
+def decode(strings, stream, out):
+    framer = Framer('cobs', crc=0)
+
+    while True:
+        # a serial port returns whatever has arrived
+        chunk = stream.read(256)
+
+        if not chunk:
+            return
+
+        errors = framer.frame_errors
+        lines = [decode_record(strings, frame) for frame in framer.decode(chunk)]
+
+        # the bytes up to the next delimiter, e.g. when starting mid record
+        if framer.frame_errors != errors:
+            lines.insert(0, '<%d garbled records skipped>' % (framer.frame_errors - errors))
+
+        for line in lines:
+            out.write(line if line.endswith('\n') else line + '\n')
+
+        out.flush()
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.stderr.write('usage: %s <sketch.elf> <serial port or capture file>\n' % sys.argv[0])
+        sys.exit(1)
+
+    strings = read_strings(sys.argv[1])
+
+    with open(sys.argv[2], 'rb', buffering=0) as stream:
+        decode(strings, stream, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,388 @@
+/*
+ * COBS and SLIP packet framing for nRF5x
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "Framing.h"
+
+#define SLIP_END      0xC0
+#define SLIP_ESC      0xDB
+#define SLIP_ESC_END  0xDC
+#define SLIP_ESC_ESC  0xDD
+
+// longest run of non-zero bytes a COBS code byte can describe
+#define COBS_MAX_RUN  254
+
+Framing::Framing(Stream &stream, uint8_t *buffer, size_t size, FramingMode mode, FramingCrc crc) :
+  stream(stream),
+  buffer(buffer),
+  size(size),
+  mode(mode),
+  crc(crc)
+{
+  callback = NULL;
+  context = NULL;
+  badCrc = 0;
+  badFrames = 0;
+
+  resetDecoder();
+}
+
+void Framing::onFrame(FramingCallback callback, void *context)
+{
+  this->callback = callback;
+  this->context = context;
+}
+
+void Framing::resetDecoder()
+{
+  length = 0;
+  overflow = false;
+  remaining = 0;
+  pendingZero = false;
+  escaped = false;
+}
+
+void Framing::poll()
+{
+  while (1)
+  {
+    if (length == size)
+    {
+      // full, but the next byte may still be the delimiter
+      uint8_t c;
+
+      if (stream.read(&c, 1) <= 0)
+      {
+        return;
+      }
+
+      decode(c);
+      continue;
+    }
+
+    // The raw bytes land right behind the decoded ones. Decoding never
+    // produces more bytes than it consumes, so it can work in place.
+    uint8_t *in = buffer + length;
+    int n = stream.read(in, size - length);
+
+    if (n <= 0)
+    {
+      return;
+    }
+
+    for (uint8_t *end = in + n; in < end; in++)
+    {
+      decode(*in);
+    }
+  }
+}
+
+void Framing::decode(uint8_t c)
+{
+  if (mode == FRAMING_COBS)
+  {
+    if (c == 0x00)
+    {
+      // a frame cut short ends in the middle of a block
+      if (remaining)
+      {
+        overflow = true;
+      }
+
+      endFrame();
+    }
+    else if (remaining == 0)
+    {
+      // code byte, the zero the previous block ended in comes first
+      if (pendingZero)
+      {
+        store(0x00);
+      }
+
+      remaining = c - 1;
+      pendingZero = (c != COBS_MAX_RUN + 1);
+    }
+    else
+    {
+      store(c);
+      remaining--;
+    }
+  }
+  else
+  {
+    if (c == SLIP_END)
+    {
+      endFrame();
+    }
+    else if (escaped)
+    {
+      escaped = false;
+
+      if (c == SLIP_ESC_END)
+      {
+        store(SLIP_END);
+      }
+      else if (c == SLIP_ESC_ESC)
+      {
+        store(SLIP_ESC);
+      }
+      else
+      {
+        overflow = true;
+      }
+    }
+    else if (c == SLIP_ESC)
+    {
+      escaped = true;
+    }
+    else
+    {
+      store(c);
+    }
+  }
+}
+
+void Framing::store(uint8_t c)
+{
+  if (length < size)
+  {
+    buffer[length++] = c;
+  }
+  else
+  {
+    // no end in sight, drop what we have and resync on the next delimiter
+    overflow = true;
+    length = 0;
+  }
+}
+
+void Framing::endFrame()
+{
+  size_t crcLength = crc;
+
+  if (overflow || escaped)
+  {
+    badFrames++;
+  }
+  else if (length == 0)
+  {
+    // back to back delimiters, SLIP senders start every frame with one
+  }
+  else if (length < crcLength)
+  {
+    badFrames++;
+  }
+  else
+  {
+    size_t payload = length - crcLength;
+    bool valid = true;
+
+    if (crc == FRAMING_CRC16)
+    {
+      uint16_t value = framingCrc16(buffer, payload);
+
+      valid = (buffer[payload] == (uint8_t)value && buffer[payload + 1] == (uint8_t)(value >> 8));
+    }
+    else if (crc == FRAMING_CRC32)
+    {
+      uint32_t value = framingCrc32(buffer, payload);
+
+      for (size_t i = 0; i < 4; i++)
+      {
+        valid = valid && (buffer[payload + i] == (uint8_t)(value >> (8 * i)));
+      }
+    }
+
+    if (!valid)
+    {
+      badCrc++;
+    }
+    else if (callback)
+    {
+      callback(buffer, payload, context);
+    }
+  }
+
+  resetDecoder();
+}
+
+size_t Framing::send(const uint8_t *data, size_t length)
+{
+  uint8_t trailer[4];
+  size_t crcLength = crc;
+
+  if (crc == FRAMING_CRC16)
+  {
+    uint16_t value = framingCrc16(data, length);
+
+    trailer[0] = value;
+    trailer[1] = value >> 8;
+  }
+  else if (crc == FRAMING_CRC32)
+  {
+    uint32_t value = framingCrc32(data, length);
+
+    for (size_t i = 0; i < 4; i++)
+    {
+      trailer[i] = value >> (8 * i);
+    }
+  }
+
+  bool sent;
+
+  if (mode == FRAMING_COBS)
+  {
+    const uint8_t end = 0x00;
+
+    sent = sendCobs(data, length, trailer, crcLength) && put(&end, 1);
+  }
+  else
+  {
+    const uint8_t end = SLIP_END;
+
+    sent = put(&end, 1) && sendSlip(data, length) && sendSlip(trailer, crcLength) && put(&end, 1);
+  }
+
+  return sent ? length : 0;
+}
+
+bool Framing::put(const uint8_t *data, size_t length)
+{
+  return length == 0 || stream.write(data, length) == length;
+}
+
+// the payload followed by its CRC, as one sequence
+static inline uint8_t byteAt(const uint8_t *data, size_t length, const uint8_t *crc, size_t i)
+{
+  return (i < length) ? data[i] : crc[i - length];
+}
+
+bool Framing::sendCobs(const uint8_t *data, size_t length, const uint8_t *crc, size_t crcLength)
+{
+  size_t total = length + crcLength;
+  size_t i = 0;
+
+  while (1)
+  {
+    size_t j = i;
+
+    while (j < total && j - i < COBS_MAX_RUN && byteAt(data, length, crc, j) != 0x00)
+    {
+      j++;
+    }
+
+    // code byte, then the run in at most two pieces
+    uint8_t code = j - i + 1;
+
+    if (!put(&code, 1))
+    {
+      return false;
+    }
+
+    if (i < length && !put(data + i, ((j < length) ? j : length) - i))
+    {
+      return false;
+    }
+
+    if (j > length)
+    {
+      size_t start = (i > length) ? i : length;
+
+      if (!put(crc + start - length, j - start))
+      {
+        return false;
+      }
+    }
+
+    if (j == total)
+    {
+      return true;
+    }
+
+    // the zero ending a short run is implied by its code byte, a full run
+    // implies none
+    if (j - i < COBS_MAX_RUN)
+    {
+      j++;
+    }
+
+    i = j;
+  }
+}
+
+size_t framingCobsEncode(const uint8_t *data, size_t length, uint8_t *out)
+{
+  uint8_t *code = out;
+  uint8_t *o = out + 1;
+
+  for (size_t i = 0; i < length; i++)
+  {
+    if (data[i] != 0x00)
+    {
+      *o++ = data[i];
+    }
+
+    // a zero closes the block, so does a full run unless it ends the data
+    if (data[i] == 0x00 || (o - code == COBS_MAX_RUN + 1 && i + 1 < length))
+    {
+      *code = o - code;
+      code = o++;
+    }
+  }
+
+  *code = o - code;
+  *o++ = 0x00;
+
+  return o - out;
+}
+
+bool Framing::sendSlip(const uint8_t *data, size_t length)
+{
+  size_t i = 0;
+
+  while (i < length)
+  {
+    size_t j = i;
+
+    while (j < length && data[j] != SLIP_END && data[j] != SLIP_ESC)
+    {
+      j++;
+    }
+
+    if (!put(data + i, j - i))
+    {
+      return false;
+    }
+
+    if (j < length)
+    {
+      uint8_t escape[2] = { SLIP_ESC, (uint8_t)((data[j] == SLIP_END) ? SLIP_ESC_END : SLIP_ESC_ESC) };
+
+      if (!put(escape, 2))
+      {
+        return false;
+      }
+
+      j++;
+    }
+
+    i = j;
+  }
+
+  return true;
+}
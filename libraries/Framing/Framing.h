@@ -0,0 +1,114 @@
+/*
+ * COBS and SLIP packet framing for nRF5x
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef Framing_h
+#define Framing_h
+
+#include <Arduino.h>
+
+enum FramingMode
+{
+  FRAMING_COBS,  // frames end with 0x00, which never appears inside one
+  FRAMING_SLIP   // RFC 1055, frames start and end with 0xC0
+};
+
+// value is the number of CRC bytes appended to every frame (little endian)
+enum FramingCrc
+{
+  FRAMING_CRC_NONE = 0,
+  FRAMING_CRC16 = 2,  // CRC-16/CCITT-FALSE
+  FRAMING_CRC32 = 4   // CRC-32 as used by zlib and Ethernet
+};
+
+// table driven, pass the previous result to continue over several pieces
+uint16_t framingCrc16(const void *data, size_t length, uint16_t crc = 0xFFFF);
+uint32_t framingCrc32(const void *data, size_t length, uint32_t crc = 0);
+
+// COBS encoded size of length bytes, with the 0x00 delimiter
+#define FRAMING_COBS_SIZE(length) ((length) + (length) / 254 + 2)
+
+// COBS encodes data into out, FRAMING_COBS_SIZE(length) bytes, for senders
+// that queue frames instead of writing them to a stream. Returns the size.
+size_t framingCobsEncode(const uint8_t *data, size_t length, uint8_t *out);
+
+// called with the payload of every frame whose CRC matched, the data is only
+// valid until the callback returns
+typedef void (*FramingCallback)(const uint8_t *data, size_t length, void *context);
+
+// Packet framing over a Stream, usually a Uart. Received bytes are read in
+// bulk straight into the caller's frame buffer and decoded in place, so a
+// frame is never copied again before the callback sees it. Frames that
+// don't fit the buffer (payload plus CRC), are malformed or fail the CRC
+// are dropped and counted.
+class Framing
+{
+  public:
+    Framing(Stream &stream, uint8_t *buffer, size_t size, FramingMode mode = FRAMING_COBS, FramingCrc crc = FRAMING_CRC16);
+
+    void onFrame(FramingCallback callback, void *context = NULL);
+
+    // Decodes what has arrived and calls the callback for each complete
+    // frame, never waits. Call it from loop().
+    void poll();
+
+    // Appends the CRC and writes the encoded frame to the stream, the
+    // payload is written in runs straight from data. Returns length, or 0
+    // if the stream didn't take all of it. Without a CRC an empty frame
+    // can't be told from back to back delimiters and is never delivered.
+    size_t send(const uint8_t *data, size_t length);
+
+    uint32_t crcErrors() { return badCrc; }
+    // overlong or malformed frames
+    uint32_t frameErrors() { return badFrames; }
+
+  private:
+    void decode(uint8_t c);
+    void endFrame();
+    void resetDecoder();
+
+    void store(uint8_t c);
+
+    bool put(const uint8_t *data, size_t length);
+    bool sendCobs(const uint8_t *data, size_t length, const uint8_t *crc, size_t crcLength);
+    bool sendSlip(const uint8_t *data, size_t length);
+
+    Stream &stream;
+    uint8_t *buffer;
+    size_t size;
+    FramingMode mode;
+    FramingCrc crc;
+
+    FramingCallback callback;
+    void *context;
+
+    // decoded bytes of the frame so far, at the start of buffer
+    size_t length;
+    bool overflow;
+
+    // COBS: data bytes left in the current block, and whether the block
+    // ends in a zero. SLIP: the previous byte was an escape.
+    uint8_t remaining;
+    bool pendingZero;
+    bool escaped;
+
+    uint32_t badCrc;
+    uint32_t badFrames;
+};
+
+#endif
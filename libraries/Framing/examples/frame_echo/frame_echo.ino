@@ -0,0 +1,37 @@
+// Packet framing echo
+//
+// Sends every frame received on Serial back with its bytes reversed. COBS
+// framing with a CRC-16, try it from the host with the reference
+// implementation in the extras folder of the library:
+//
+//   stty -F /dev/ttyACM0 115200 raw
+//   python3 framing.py /dev/ttyACM0 cobs 16
+
+#include <Framing.h>
+
+uint8_t frameBuffer[130]; // up to 128 byte payloads plus the CRC
+
+Framing link(Serial, frameBuffer, sizeof(frameBuffer), FRAMING_COBS, FRAMING_CRC16);
+
+void onFrame(const uint8_t *data, size_t length, void *context)
+{
+  uint8_t reply[128];
+
+  for (size_t i = 0; i < length; i++)
+  {
+    reply[i] = data[length - 1 - i];
+  }
+
+  link.send(reply, length);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  link.onFrame(onFrame);
+}
+
+void loop()
+{
+  link.poll();
+}
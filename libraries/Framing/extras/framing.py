@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+#
+# Host side reference implementation of the Framing library: COBS or SLIP
+# framing with an optional little endian CRC-16/CCITT-FALSE or CRC-32
+# trailer, byte for byte what the sketch sends and expects.
+#
+#   from framing import Framer
+#
+#   link = Framer('cobs', crc=16)
+#   port.write(link.encode(b'hello'))
+#   for frame in link.decode(port.read(port.in_waiting)):
+#       print(frame)
+#
+# Run on its own it sends each line read from stdin as a frame and prints
+# the frames coming back, as with the frame_echo example:
+#
+#   stty -F /dev/ttyACM0 115200 raw
+#   framing.py /dev/ttyACM0 cobs 16
+
+import binascii
+import os
+import select
+import struct
+import sys
+
+SLIP_END = 0xc0
+SLIP_ESC = 0xdb
+SLIP_ESC_END = 0xdc
+SLIP_ESC_ESC = 0xdd
+
+
+def crc16(data, crc=0xffff):
+    for byte in data:
+        crc ^= byte << 8
+
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xffff
+
+    return crc
+
+
+def crc32(data, crc=0):
+    return binascii.crc32(data, crc) & 0xffffffff
+
+
+def cobs_encode(data):
+    out = bytearray()
+    start = 0
+
+    while True:
+        end = start
+
+        while end < len(data) and end - start < 254 and data[end] != 0:
+            end += 1
+
+        out.append(end - start + 1)
+        out += data[start:end]
+
+        if end == len(data):
+            return bytes(out) + b'\0'
+
+        # the zero ending a short run is implied by its code byte, a full
+        # run implies none
+        start = end + 1 if end - start < 254 else end
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+
+    while i < len(data):
+        code = data[i]
+        block = data[i + 1:i + code]
+
+        if code == 0 or len(block) != code - 1 or 0 in block:
+            raise ValueError('malformed COBS frame')
+
+        out += block
+        i += code
+
+        if code != 255 and i < len(data):
+            out.append(0)
+
+    return bytes(out)
+
+
+def slip_encode(data):
+    data = data.replace(bytes([SLIP_ESC]), bytes([SLIP_ESC, SLIP_ESC_ESC]))
+    data = data.replace(bytes([SLIP_END]), bytes([SLIP_ESC, SLIP_ESC_END]))
+
+    return bytes([SLIP_END]) + data + bytes([SLIP_END])
+
+
+def slip_decode(data):
+    out = bytearray()
+    escaped = False
+
+    for byte in data:
+        if escaped:
+            if byte == SLIP_ESC_END:
+                out.append(SLIP_END)
+            elif byte == SLIP_ESC_ESC:
+                out.append(SLIP_ESC)
+            else:
+                raise ValueError('malformed SLIP frame')
+
+            escaped = False
+        elif byte == SLIP_ESC:
+            escaped = True
+        else:
+            out.append(byte)
+
+    if escaped:
+        raise ValueError('malformed SLIP frame')
+
+    return bytes(out)
+
+
+class Framer:
+    def __init__(self, mode='cobs', crc=16):
+        if mode not in ('cobs', 'slip') or crc not in (0, 16, 32):
+            raise ValueError('mode is cobs or slip, crc 0, 16 or 32')
+
+        self.mode = mode
+        self.crc = crc
+        self.pending = bytearray()
+        self.crc_errors = 0
+        self.frame_errors = 0
+
+    def trailer(self, data):
+        if self.crc == 16:
+            return struct.pack('<H', crc16(data))
+
+        if self.crc == 32:
+            return struct.pack('<I', crc32(data))
+
+        return b''
+
+    def encode(self, data):
+        data = bytes(data) + self.trailer(bytes(data))
+
+        return cobs_encode(data) if self.mode == 'cobs' else slip_encode(data)
+
+    def decode(self, data):
+        """Feed received bytes, returns the payloads of the frames completed."""
+        delimiter = 0 if self.mode == 'cobs' else SLIP_END
+        frames = []
+
+        self.pending += data
+
+        while delimiter in self.pending:
+            end = self.pending.index(delimiter)
+            raw = bytes(self.pending[:end])
+            del self.pending[:end + 1]
+
+            # back to back delimiters
+            if not raw:
+                continue
+
+            try:
+                frame = cobs_decode(raw) if self.mode == 'cobs' else slip_decode(raw)
+            except ValueError:
+                self.frame_errors += 1
+                continue
+
+            size = self.crc // 8
+
+            if len(frame) < size:
+                self.frame_errors += 1
+            elif self.trailer(frame[:len(frame) - size]) != frame[len(frame) - size:]:
+                self.crc_errors += 1
+            else:
+                frames.append(frame[:len(frame) - size])
+
+        return frames
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.stderr.write('usage: %s <serial port> [cobs|slip] [0|16|32]\n' % sys.argv[0])
+        sys.exit(1)
+
+    mode = sys.argv[2] if len(sys.argv) > 2 else 'cobs'
+    crc = int(sys.argv[3]) if len(sys.argv) > 3 else 16
+    link = Framer(mode, crc)
+
+    port = os.open(sys.argv[1], os.O_RDWR | os.O_NOCTTY)
+
+    while True:
+        readable, _, _ = select.select([sys.stdin, port], [], [])
+
+        if sys.stdin in readable:
+            line = sys.stdin.readline()
+
+            if not line:
+                return
+
+            os.write(port, link.encode(line.rstrip('\n').encode()))
+
+        if port in readable:
+            for frame in link.decode(os.read(port, 4096)):
+                print(repr(frame))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,81 @@
+/*
+ * Non-blocking line reader for nRF5x
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "LineReader.h"
+
+LineReader::LineReader(Stream &stream, char *buffer, size_t size) :
+  stream(stream),
+  buffer(buffer),
+  size(size)
+{
+  reset();
+}
+
+void LineReader::reset()
+{
+  count = 0;
+  overflow = false;
+  complete = false;
+
+  if (size)
+  {
+    buffer[0] = '\0';
+  }
+}
+
+bool LineReader::poll()
+{
+  if (complete)
+  {
+    // the last line has been handed out, start the next one
+    reset();
+  }
+
+  while (1)
+  {
+    int c = stream.read();
+
+    if (c < 0)
+    {
+      return false;
+    }
+
+    if (c == '\n')
+    {
+      complete = true;
+      return true;
+    }
+
+    if (c == '\r')
+    {
+      continue;
+    }
+
+    // one byte is kept for the terminator
+    if (count + 1 < size)
+    {
+      buffer[count++] = (char)c;
+      buffer[count] = '\0';
+    }
+    else
+    {
+      overflow = true;
+    }
+  }
+}
@@ -0,0 +1,56 @@
+/*
+ * Non-blocking line reader for nRF5x
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef LineReader_h
+#define LineReader_h
+
+#include <Arduino.h>
+
+// Collects lines from a stream into a caller provided buffer without
+// blocking or allocating. poll() takes whatever has arrived and returns
+// true once a line ending in '\n' is complete; '\r' is dropped so CR LF
+// terminated lines (NMEA, AT responses) come out clean. The line stays
+// valid until the next poll(). Lines longer than the buffer are cut to
+// size - 1 characters, the rest up to the '\n' is discarded and
+// truncated() is set.
+class LineReader
+{
+  public:
+    LineReader(Stream &stream, char *buffer, size_t size);
+
+    bool poll();
+
+    // NUL terminated, without the line ending
+    const char *line() const { return buffer; }
+    size_t length() const { return count; }
+    bool truncated() const { return overflow; }
+
+    // drops a partially received line
+    void reset();
+
+  private:
+    Stream &stream;
+    char *buffer;
+    size_t size;
+    size_t count;
+    bool overflow;
+    bool complete;
+};
+
+#endif
@@ -0,0 +1,36 @@
+// Non-blocking line reader
+//
+// Picks complete NMEA sentences off a GPS module on Serial while loop()
+// keeps running, no String is allocated and nothing waits for the rest of
+// a sentence.
+
+#include <LineReader.h>
+
+char lineBuffer[83]; // longest NMEA sentence is 82 characters
+
+LineReader gps(Serial, lineBuffer, sizeof(lineBuffer));
+
+void setup()
+{
+  Serial.begin(9600);
+  pinMode(LED_BUILTIN, OUTPUT);
+}
+
+void loop()
+{
+  if (gps.poll())
+  {
+    if (gps.truncated())
+    {
+      Serial.println("line too long");
+    }
+    else if (gps.length() > 6 && strncmp(gps.line(), "$GPGGA", 6) == 0)
+    {
+      Serial.write(gps.line(), gps.length());
+      Serial.println();
+    }
+  }
+
+  // free for other work meanwhile
+  digitalWrite(LED_BUILTIN, (millis() / 500) % 2);
+}
@@ -31,6 +31,10 @@
 
 const SPISettings DEFAULT_SPI_SETTINGS = SPISettings();
 
+#ifdef SPI_HAS_SPIM
+static SPIClass *spim3Instance = NULL;
+#endif
+
 SPIClass::SPIClass(NRF_SPI_Type *p_spi, uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI)
 {
   initialized = false;
@@ -44,7 +48,59 @@ SPIClass::SPIClass(NRF_SPI_Type *p_spi, uint8_t uc_pinMISO, uint8_t uc_pinSCK, u
 
   _dataMode = SPI_MODE0;
   _bitOrder = SPI_CONFIG_ORDER_MsbFirst;
+
+#ifdef SPI_HAS_SPIM
+  _p_spim = NULL;
+  _uc_pinCS = 0xff;
+  _csDuration = 0;
+  _pacingTimer = NULL;
+  _counterTimer = NULL;
+  onBlockCallback = NULL;
+#endif
+}
+
+#ifdef SPI_HAS_SPIM
+SPIClass::SPIClass(NRF_SPIM_Type *p_spim, uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI)
+{
+  initialized = false;
+  assert(p_spim != NULL);
+  _p_spi = NULL;
+  _p_spim = p_spim;
+
+  // pins
+  _uc_pinMiso = g_ADigitalPinMap[uc_pinMISO];
+  _uc_pinSCK = g_ADigitalPinMap[uc_pinSCK];
+  _uc_pinMosi = g_ADigitalPinMap[uc_pinMOSI];
+  _uc_pinCS = 0xff;
+  _csDuration = 0;
+  _pacingTimer = NULL;
+  _counterTimer = NULL;
+  onBlockCallback = NULL;
+
+  _dataMode = SPI_MODE0;
+  _bitOrder = SPI_CONFIG_ORDER_MsbFirst;
+}
+
+void SPIClass::setHardwareCS(uint8_t uc_pinCS, uint8_t csDuration)
+{
+  _uc_pinCS = uc_pinCS;
+  _csDuration = csDuration;
+
+  if (initialized) {
+    pinMode(_uc_pinCS, OUTPUT);
+    digitalWrite(_uc_pinCS, HIGH);
+
+    // PSEL and the CS timing only take effect while the SPIM is disabled
+    _p_spim->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
+
+    _p_spim->PSEL.CSN = g_ADigitalPinMap[_uc_pinCS];
+    _p_spim->CSNPOL = (SPIM_CSNPOL_CSNPOL_LOW << SPIM_CSNPOL_CSNPOL_Pos);
+    _p_spim->IFTIMING.CSNDUR = _csDuration;
+
+    _p_spim->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
+  }
 }
+#endif
 
 #ifdef ARDUINO_GENERIC
 void SPIClass::setPins(uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI)
@@ -59,6 +115,29 @@ void SPIClass::begin()
 {
   init();
 
+#ifdef SPI_HAS_SPIM
+  if (_p_spim) {
+    _p_spim->PSEL.SCK  = _uc_pinSCK;
+    _p_spim->PSEL.MOSI = _uc_pinMosi;
+    _p_spim->PSEL.MISO = _uc_pinMiso;
+
+    if (_uc_pinCS != 0xff) {
+      // CS idles high, so drive it before the SPIM takes the pin over
+      pinMode(_uc_pinCS, OUTPUT);
+      digitalWrite(_uc_pinCS, HIGH);
+
+      _p_spim->PSEL.CSN = g_ADigitalPinMap[_uc_pinCS];
+      _p_spim->CSNPOL = (SPIM_CSNPOL_CSNPOL_LOW << SPIM_CSNPOL_CSNPOL_Pos);
+      _p_spim->IFTIMING.CSNDUR = _csDuration;
+    }
+
+    _p_spim->ORC = 0xff;
+
+    config(DEFAULT_SPI_SETTINGS);
+    return;
+  }
+#endif
+
   _p_spi->PSELSCK  = _uc_pinSCK;
   _p_spi->PSELMOSI = _uc_pinMosi;
   _p_spi->PSELMISO = _uc_pinMiso;
@@ -78,8 +157,6 @@ void SPIClass::init()
 
 void SPIClass::config(SPISettings settings)
 {
-  _p_spi->ENABLE = (SPI_ENABLE_ENABLE_Disabled << SPI_ENABLE_ENABLE_Pos);
-
   uint32_t config = settings.bitOrder;
 
   switch (settings.dataMode) {
@@ -105,14 +182,54 @@ void SPIClass::config(SPISettings settings)
       break;
   }
 
+#ifdef SPI_HAS_SPIM
+  if (_p_spim) {
+    _p_spim->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
+
+    _p_spim->CONFIG = config;
+    _p_spim->FREQUENCY = settings.clockFreq;
+
+    _p_spim->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
+    return;
+  }
+
+  // the legacy SPI peripheral tops out at 8 MHz
+  if (settings.clockFreq == SPIM_FREQUENCY_FREQUENCY_M16 || settings.clockFreq == SPIM_FREQUENCY_FREQUENCY_M32) {
+    settings.clockFreq = SPI_FREQUENCY_FREQUENCY_M8;
+  }
+#endif
+
+  _p_spi->ENABLE = (SPI_ENABLE_ENABLE_Disabled << SPI_ENABLE_ENABLE_Pos);
+
   _p_spi->CONFIG = config;
   _p_spi->FREQUENCY = settings.clockFreq;
 
   _p_spi->ENABLE = (SPI_ENABLE_ENABLE_Enabled << SPI_ENABLE_ENABLE_Pos);
 }
 
+void SPIClass::setConfig(uint32_t config)
+{
+#ifdef SPI_HAS_SPIM
+  if (_p_spim) {
+    _p_spim->CONFIG = config;
+    return;
+  }
+#endif
+
+  _p_spi->CONFIG = config;
+}
+
 void SPIClass::end()
 {
+#ifdef SPI_HAS_SPIM
+  if (_p_spim) {
+    _p_spim->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
+
+    initialized = false;
+    return;
+  }
+#endif
+
   _p_spi->ENABLE = (SPI_ENABLE_ENABLE_Disabled << SPI_ENABLE_ENABLE_Pos);
 
   initialized = false;
@@ -160,7 +277,7 @@ void SPIClass::setBitOrder(BitOrder order)
       break;
   }
 
-  _p_spi->CONFIG = config;
+  setConfig(config);
 }
 
 void SPIClass::setDataMode(uint8_t mode)
@@ -192,7 +309,7 @@ void SPIClass::setDataMode(uint8_t mode)
       break;
   }
 
-  _p_spi->CONFIG = config;
+  setConfig(config);
 }
 
 void SPIClass::setClockDivider(uint8_t div)
@@ -215,11 +332,26 @@ void SPIClass::setClockDivider(uint8_t div)
     clockFreq = SPI_FREQUENCY_FREQUENCY_M8;
   }
 
+#ifdef SPI_HAS_SPIM
+  if (_p_spim) {
+    _p_spim->FREQUENCY = clockFreq;
+    return;
+  }
+#endif
+
   _p_spi->FREQUENCY = clockFreq;
 }
 
 byte SPIClass::transfer(uint8_t data)
 {
+#ifdef SPI_HAS_SPIM
+  if (_p_spim) {
+    transfer(&data, &data, 1);
+
+    return data;
+  }
+#endif
+
   _p_spi->TXD = data;
 
   while(!_p_spi->EVENTS_READY);
@@ -247,6 +379,181 @@ uint16_t SPIClass::transfer16(uint16_t data) {
   return t.val;
 }
 
+void SPIClass::transfer(void *buf, size_t count)
+{
+#ifdef SPI_HAS_SPIM
+  if (_p_spim) {
+    transfer(buf, buf, count);
+    return;
+  }
+#endif
+
+  // TODO: Optimize for faster block-transfer
+  uint8_t *buffer = reinterpret_cast<uint8_t *>(buf);
+  for (size_t i=0; i<count; i++)
+    buffer[i] = transfer(buffer[i]);
+}
+
+#ifdef SPI_HAS_SPIM
+void SPIClass::transfer(const void *txbuf, void *rxbuf, size_t count)
+{
+  const uint8_t *txBuffer = reinterpret_cast<const uint8_t *>(txbuf);
+  uint8_t *rxBuffer = reinterpret_cast<uint8_t *>(rxbuf);
+
+  while (count) {
+    // MAXCNT is 16 bits wide on SPIM3, split larger transfers
+    size_t chunk = count > 0xffff ? 0xffff : count;
+
+    _p_spim->TXD.PTR = (uint32_t)txBuffer;
+    _p_spim->TXD.MAXCNT = txBuffer ? chunk : 0;
+    _p_spim->RXD.PTR = (uint32_t)rxBuffer;
+    _p_spim->RXD.MAXCNT = rxBuffer ? chunk : 0;
+
+    _p_spim->EVENTS_END = 0x0UL;
+    _p_spim->TASKS_START = 0x1UL;
+
+    while(!_p_spim->EVENTS_END);
+
+    _p_spim->EVENTS_END = 0x0UL;
+
+    if (txBuffer) txBuffer += chunk;
+    if (rxBuffer) rxBuffer += chunk;
+    count -= chunk;
+  }
+}
+
+bool SPIClass::beginSampling(NRF_TIMER_Type *pacingTimer, NRF_TIMER_Type *counterTimer, uint32_t intervalUs,
+                             const uint8_t *command, size_t frameLength, uint8_t *buffer, size_t blockFrames,
+                             void(*onBlock)(uint8_t *, size_t))
+{
+  // only SPIM3 has an interrupt line of its own
+  if (_p_spim != NRF_SPIM3 || frameLength == 0 || blockFrames == 0) {
+    return false;
+  }
+
+  spim3Instance = this;
+
+  _pacingTimer = pacingTimer;
+  _counterTimer = counterTimer;
+  _sampleBuffer = buffer;
+  _sampleBlockSize = blockFrames * frameLength;
+  _sampleBlockFrames = blockFrames;
+  _sampleBank = 0;
+  onBlockCallback = onBlock;
+
+  // same command for every frame, replies are appended back to back
+  _p_spim->TXD.PTR = (uint32_t)command;
+  _p_spim->TXD.MAXCNT = command ? frameLength : 0;
+  _p_spim->TXD.LIST = (SPIM_TXD_LIST_LIST_Disabled << SPIM_TXD_LIST_LIST_Pos);
+  _p_spim->RXD.PTR = (uint32_t)buffer;
+  _p_spim->RXD.MAXCNT = frameLength;
+  _p_spim->RXD.LIST = (SPIM_RXD_LIST_LIST_ArrayList << SPIM_RXD_LIST_LIST_Pos);
+
+  // 1 MHz time base, a START every intervalUs
+  _pacingTimer->TASKS_STOP = 0x1UL;
+  _pacingTimer->TASKS_CLEAR = 0x1UL;
+  _pacingTimer->MODE = (TIMER_MODE_MODE_Timer << TIMER_MODE_MODE_Pos);
+  _pacingTimer->BITMODE = (TIMER_BITMODE_BITMODE_32Bit << TIMER_BITMODE_BITMODE_Pos);
+  _pacingTimer->PRESCALER = 4;
+  _pacingTimer->CC[0] = intervalUs;
+  _pacingTimer->SHORTS = TIMER_SHORTS_COMPARE0_CLEAR_Msk;
+
+  // counts END events, STOPs the SPIM once a block is full so STOPPED
+  // raises the SPIM3 interrupt, and the pacing timer with it so no frame
+  // starts before the interrupt has moved RXD.PTR to the other bank
+  _counterTimer->TASKS_STOP = 0x1UL;
+  _counterTimer->TASKS_CLEAR = 0x1UL;
+  _counterTimer->MODE = (TIMER_MODE_MODE_Counter << TIMER_MODE_MODE_Pos);
+  _counterTimer->BITMODE = (TIMER_BITMODE_BITMODE_32Bit << TIMER_BITMODE_BITMODE_Pos);
+  _counterTimer->CC[0] = blockFrames;
+  _counterTimer->SHORTS = TIMER_SHORTS_COMPARE0_CLEAR_Msk;
+
+  NRF_PPI->CH[SPI_SAMPLING_PPI_CHANNEL].EEP = (uint32_t)&_pacingTimer->EVENTS_COMPARE[0];
+  NRF_PPI->CH[SPI_SAMPLING_PPI_CHANNEL].TEP = (uint32_t)&_p_spim->TASKS_START;
+  NRF_PPI->CH[SPI_SAMPLING_PPI_CHANNEL + 1].EEP = (uint32_t)&_p_spim->EVENTS_END;
+  NRF_PPI->CH[SPI_SAMPLING_PPI_CHANNEL + 1].TEP = (uint32_t)&_counterTimer->TASKS_COUNT;
+  NRF_PPI->CH[SPI_SAMPLING_PPI_CHANNEL + 2].EEP = (uint32_t)&_counterTimer->EVENTS_COMPARE[0];
+  NRF_PPI->CH[SPI_SAMPLING_PPI_CHANNEL + 2].TEP = (uint32_t)&_p_spim->TASKS_STOP;
+  NRF_PPI->FORK[SPI_SAMPLING_PPI_CHANNEL + 2].TEP = (uint32_t)&_pacingTimer->TASKS_STOP;
+
+  _p_spim->EVENTS_END = 0x0UL;
+  _p_spim->EVENTS_STOPPED = 0x0UL;
+  _p_spim->INTENSET = SPIM_INTENSET_STOPPED_Msk;
+
+  NVIC_ClearPendingIRQ(SPIM3_IRQn);
+  NVIC_SetPriority(SPIM3_IRQn, 2);
+  NVIC_EnableIRQ(SPIM3_IRQn);
+
+  NRF_PPI->CHENSET = (7UL << SPI_SAMPLING_PPI_CHANNEL);
+
+  _counterTimer->TASKS_START = 0x1UL;
+  _pacingTimer->TASKS_START = 0x1UL;
+
+  return true;
+}
+
+void SPIClass::endSampling()
+{
+  if (_pacingTimer == NULL) {
+    return;
+  }
+
+  _pacingTimer->TASKS_STOP = 0x1UL;
+  _counterTimer->TASKS_STOP = 0x1UL;
+
+  NRF_PPI->CHENCLR = (7UL << SPI_SAMPLING_PPI_CHANNEL);
+  NRF_PPI->FORK[SPI_SAMPLING_PPI_CHANNEL + 2].TEP = 0;
+
+  NVIC_DisableIRQ(SPIM3_IRQn);
+  _p_spim->INTENCLR = SPIM_INTENCLR_STOPPED_Msk;
+
+  // abort a frame in flight before handing the SPIM back
+  _p_spim->EVENTS_STOPPED = 0x0UL;
+  _p_spim->TASKS_STOP = 0x1UL;
+  while(!_p_spim->EVENTS_STOPPED);
+  _p_spim->EVENTS_STOPPED = 0x0UL;
+
+  _p_spim->RXD.LIST = (SPIM_RXD_LIST_LIST_Disabled << SPIM_RXD_LIST_LIST_Pos);
+
+  _pacingTimer = NULL;
+  _counterTimer = NULL;
+  spim3Instance = NULL;
+}
+
+void SPIClass::onService()
+{
+  if (_p_spim->EVENTS_STOPPED)
+  {
+    _p_spim->EVENTS_STOPPED = 0x0UL;
+
+    uint8_t *block = _sampleBuffer + _sampleBank * _sampleBlockSize;
+
+    // the pacing timer was stopped with the SPIM, so ArrayList can't run
+    // past the end of the bank; a late interrupt delays the next frame
+    // instead of overrunning the buffer
+    _sampleBank ^= 1;
+    _p_spim->RXD.PTR = (uint32_t)(_sampleBuffer + _sampleBank * _sampleBlockSize);
+    _pacingTimer->TASKS_START = 0x1UL;
+
+    if (onBlockCallback)
+    {
+      onBlockCallback(block, _sampleBlockFrames);
+    }
+  }
+}
+
+extern "C"
+{
+  void SPIM3_IRQHandler(void)
+  {
+    if (spim3Instance)
+    {
+      spim3Instance->onService();
+    }
+  }
+}
+#endif
+
 void SPIClass::attachInterrupt() {
   // Should be enableInterrupt()
 }
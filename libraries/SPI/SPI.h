@@ -30,6 +30,19 @@
 //   - SPISetting(clock, bitOrder, dataMode)
 #define SPI_HAS_TRANSACTION 1
 
+// SPI_HAS_SPIM means SPIClass can also drive an EasyDMA SPIM instance
+// (SPIM3 on nRF52833/nRF52840) with 16/32 MHz clocks and hardware chip select
+#if defined(NRF52_SERIES) && defined(SPIM3_MAX_DATARATE)
+#define SPI_HAS_SPIM 1
+
+// first of the three PPI channels used by SPIClass::beginSampling(), the
+// channels SPI_SAMPLING_PPI_CHANNEL to SPI_SAMPLING_PPI_CHANNEL + 2 (and the
+// fork of the last one) belong to it until endSampling()
+#ifndef SPI_SAMPLING_PPI_CHANNEL
+#define SPI_SAMPLING_PPI_CHANNEL 0
+#endif
+#endif
+
 #define SPI_MODE0 0x02
 #define SPI_MODE1 0x00
 #define SPI_MODE2 0x03
@@ -67,9 +80,19 @@ class SPISettings {
       this->clockFreq = SPI_FREQUENCY_FREQUENCY_M2;
     } else if (clock <= 4000000) {
       this->clockFreq = SPI_FREQUENCY_FREQUENCY_M4;
+#ifdef SPI_HAS_SPIM
+    } else if (clock <= 8000000) {
+      this->clockFreq = SPI_FREQUENCY_FREQUENCY_M8;
+    } else if (clock <= 16000000) {
+      this->clockFreq = SPIM_FREQUENCY_FREQUENCY_M16;
+    } else {
+      this->clockFreq = SPIM_FREQUENCY_FREQUENCY_M32;
+    }
+#else
     } else {
       this->clockFreq = SPI_FREQUENCY_FREQUENCY_M8;
     }
+#endif
 
     this->bitOrder = (bitOrder == MSBFIRST ? SPI_CONFIG_ORDER_MsbFirst : SPI_CONFIG_ORDER_LsbFirst);
     this->dataMode = dataMode;
@@ -85,11 +108,43 @@ class SPISettings {
 class SPIClass {
   public:
   SPIClass(NRF_SPI_Type *p_spi, uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI);
-
+#ifdef SPI_HAS_SPIM
+  // No instance is predefined for SPIM3, the variants keep SPI on SPI2. Make
+  // one in the sketch, with the pins it should use:
+  //
+  //   SPIClass fastSPI(NRF_SPIM3, PIN_SPI_MISO, PIN_SPI_SCK, PIN_SPI_MOSI);
+  //
+  // and don't begin() SPI on the same pins at the same time.
+  SPIClass(NRF_SPIM_Type *p_spim, uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI);
+#endif
 
   byte transfer(uint8_t data);
   uint16_t transfer16(uint16_t data);
-  inline void transfer(void *buf, size_t count);
+  void transfer(void *buf, size_t count);
+#ifdef SPI_HAS_SPIM
+  // EasyDMA block transfer, txbuf and rxbuf must be in RAM (either may be NULL)
+  void transfer(const void *txbuf, void *rxbuf, size_t count);
+
+  // Let the SPIM drive CS in hardware, it is asserted for the length of every
+  // transfer. csDuration is the CS to clock delay in 64 MHz cycles.
+  void setHardwareCS(uint8_t uc_pinCS, uint8_t csDuration = 2);
+
+  // Hardware paced sampling (SPIM3 only): every intervalUs pacingTimer starts
+  // a transfer of frameLength bytes through PPI, the command is clocked out
+  // and the reply is appended to buffer (RXD.LIST = ArrayList). counterTimer
+  // counts the frames, onBlock is called from the interrupt each time
+  // blockFrames frames are complete. buffer must hold 2 * blockFrames *
+  // frameLength bytes, one half is filled while the other is handed out.
+  // Both timers, the SPIM3 interrupt and three PPI channels from
+  // SPI_SAMPLING_PPI_CHANNEL are reserved until endSampling(). The pacing
+  // timer pauses at the end of each block until the interrupt has switched
+  // halves, so a late interrupt delays that frame rather than losing data.
+  bool beginSampling(NRF_TIMER_Type *pacingTimer, NRF_TIMER_Type *counterTimer, uint32_t intervalUs,
+                     const uint8_t *command, size_t frameLength, uint8_t *buffer, size_t blockFrames,
+                     void(*onBlock)(uint8_t *samples, size_t frames));
+  void endSampling();
+  void onService();
+#endif
 
   // Transaction Functions
   void usingInterrupt(int interruptNumber);
@@ -113,8 +168,22 @@ class SPIClass {
   private:
   void init();
   void config(SPISettings settings);
+  void setConfig(uint32_t config);
 
   NRF_SPI_Type *_p_spi;
+#ifdef SPI_HAS_SPIM
+  NRF_SPIM_Type *_p_spim;
+  uint8_t _uc_pinCS;
+  uint8_t _csDuration;
+
+  NRF_TIMER_Type *_pacingTimer;
+  NRF_TIMER_Type *_counterTimer;
+  uint8_t *_sampleBuffer;
+  size_t _sampleBlockSize;
+  size_t _sampleBlockFrames;
+  volatile uint8_t _sampleBank;
+  void (*onBlockCallback)(uint8_t *, size_t);
+#endif
   uint8_t _uc_pinMiso;
   uint8_t _uc_pinMosi;
   uint8_t _uc_pinSCK;
@@ -128,14 +197,6 @@ class SPIClass {
   uint32_t interruptMask;
 };
 
-void SPIClass::transfer(void *buf, size_t count)
-{
-  // TODO: Optimize for faster block-transfer
-  uint8_t *buffer = reinterpret_cast<uint8_t *>(buf);
-  for (size_t i=0; i<count; i++)
-    buffer[i] = transfer(buffer[i]);
-}
-
 #if SPI_INTERFACES_COUNT > 0
 extern SPIClass SPI;
 #endif
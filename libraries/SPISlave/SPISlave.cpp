@@ -0,0 +1,210 @@
+/*
+ * SPI Slave library for nRF52.
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <nrf.h>
+
+#if defined(NRF52_SERIES)
+
+extern "C" {
+#include <string.h>
+}
+
+#include <Arduino.h>
+#include <wiring_private.h>
+
+#include "SPISlave.h"
+
+static SPISlave *spis2Instance = NULL;
+
+SPISlave::SPISlave(NRF_SPIS_Type *p_spis, IRQn_Type IRQn, uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI, uint8_t uc_pinCS)
+{
+  _p_spis = p_spis;
+  _IRQn = IRQn;
+
+  // pins
+  _uc_pinMiso = g_ADigitalPinMap[uc_pinMISO];
+  _uc_pinSCK = g_ADigitalPinMap[uc_pinSCK];
+  _uc_pinMosi = g_ADigitalPinMap[uc_pinMOSI];
+  _uc_pinCS = g_ADigitalPinMap[uc_pinCS];
+
+  _txLength[0] = 0;
+  _txLength[1] = 0;
+  _bank = 0;
+  _received = false;
+  _rxAmount = 0;
+
+  onReceiveCallback = NULL;
+}
+
+void SPISlave::begin(uint8_t dataMode, BitOrder bitOrder)
+{
+  if (_p_spis == NRF_SPIS2) {
+    spis2Instance = this;
+  }
+
+  _p_spis->PSEL.SCK  = _uc_pinSCK;
+  _p_spis->PSEL.MISO = _uc_pinMiso;
+  _p_spis->PSEL.MOSI = _uc_pinMosi;
+  _p_spis->PSEL.CSN  = _uc_pinCS;
+
+  uint32_t config = (bitOrder == MSBFIRST ? SPIS_CONFIG_ORDER_MsbFirst : SPIS_CONFIG_ORDER_LsbFirst) << SPIS_CONFIG_ORDER_Pos;
+
+  switch (dataMode) {
+    default:
+    case SPI_MODE0:
+      config |= (SPIS_CONFIG_CPOL_ActiveHigh << SPIS_CONFIG_CPOL_Pos);
+      config |= (SPIS_CONFIG_CPHA_Leading    << SPIS_CONFIG_CPHA_Pos);
+      break;
+
+    case SPI_MODE1:
+      config |= (SPIS_CONFIG_CPOL_ActiveHigh << SPIS_CONFIG_CPOL_Pos);
+      config |= (SPIS_CONFIG_CPHA_Trailing   << SPIS_CONFIG_CPHA_Pos);
+      break;
+
+    case SPI_MODE2:
+      config |= (SPIS_CONFIG_CPOL_ActiveLow  << SPIS_CONFIG_CPOL_Pos);
+      config |= (SPIS_CONFIG_CPHA_Leading    << SPIS_CONFIG_CPHA_Pos);
+      break;
+
+    case SPI_MODE3:
+      config |= (SPIS_CONFIG_CPOL_ActiveLow  << SPIS_CONFIG_CPOL_Pos);
+      config |= (SPIS_CONFIG_CPHA_Trailing   << SPIS_CONFIG_CPHA_Pos);
+      break;
+  }
+
+  _p_spis->CONFIG = config;
+
+  // clocked out when the semaphore is not released / past TXD.MAXCNT
+  _p_spis->DEF = 0xff;
+  _p_spis->ORC = 0xff;
+
+  _bank = 0;
+  _received = false;
+
+  // the CPU gets the semaphore back as soon as a transaction ends
+  _p_spis->SHORTS = SPIS_SHORTS_END_ACQUIRE_Msk;
+
+  _p_spis->EVENTS_END = 0x0UL;
+  _p_spis->EVENTS_ACQUIRED = 0x0UL;
+  _p_spis->INTENSET = SPIS_INTENSET_END_Msk | SPIS_INTENSET_ACQUIRED_Msk;
+
+  NVIC_ClearPendingIRQ(_IRQn);
+  NVIC_SetPriority(_IRQn, 2);
+  NVIC_EnableIRQ(_IRQn);
+
+  _p_spis->ENABLE = (SPIS_ENABLE_ENABLE_Enabled << SPIS_ENABLE_ENABLE_Pos);
+
+  // buffers are armed once the CPU holds the semaphore
+  _p_spis->TASKS_ACQUIRE = 0x1UL;
+}
+
+void SPISlave::end()
+{
+  NVIC_DisableIRQ(_IRQn);
+
+  _p_spis->INTENCLR = SPIS_INTENCLR_END_Msk | SPIS_INTENCLR_ACQUIRED_Msk;
+  _p_spis->SHORTS = 0;
+
+  _p_spis->ENABLE = (SPIS_ENABLE_ENABLE_Disabled << SPIS_ENABLE_ENABLE_Pos);
+
+  if (spis2Instance == this) {
+    spis2Instance = NULL;
+  }
+}
+
+size_t SPISlave::write(const uint8_t *data, size_t length)
+{
+  if (length > SPI_SLAVE_BUFFER_SIZE) {
+    length = SPI_SLAVE_BUFFER_SIZE;
+  }
+
+  // the pair not owned by the SPIS, its TX length is latched in arm()
+  NVIC_DisableIRQ(_IRQn);
+
+  uint8_t bank = _bank ^ 1;
+
+  memcpy(_txBuffer[bank], data, length);
+  _txLength[bank] = length;
+
+  NVIC_EnableIRQ(_IRQn);
+
+  return length;
+}
+
+void SPISlave::onReceive(void(*function)(const uint8_t *, size_t))
+{
+  onReceiveCallback = function;
+}
+
+void SPISlave::arm()
+{
+  uint8_t bank = _bank;
+
+  _p_spis->RXD.PTR = (uint32_t)_rxBuffer[bank];
+  _p_spis->RXD.MAXCNT = SPI_SLAVE_BUFFER_SIZE;
+  _p_spis->TXD.PTR = (uint32_t)_txBuffer[bank];
+  _p_spis->TXD.MAXCNT = _txLength[bank];
+
+  _p_spis->TASKS_RELEASE = 0x1UL;
+}
+
+void SPISlave::onService(void)
+{
+  if (_p_spis->EVENTS_END)
+  {
+    _p_spis->EVENTS_END = 0x0UL;
+
+    _rxAmount = _p_spis->RXD.AMOUNT;
+    _received = true;
+
+    // reply is one shot, the next transaction goes to the other pair
+    _txLength[_bank] = 0;
+    _bank ^= 1;
+  }
+
+  if (_p_spis->EVENTS_ACQUIRED)
+  {
+    _p_spis->EVENTS_ACQUIRED = 0x0UL;
+
+    arm();
+
+    if (_received)
+    {
+      _received = false;
+
+      if (onReceiveCallback)
+      {
+        onReceiveCallback(_rxBuffer[_bank ^ 1], _rxAmount);
+      }
+    }
+  }
+}
+
+extern "C"
+{
+  void SPIM2_SPIS2_SPI2_IRQHandler(void)
+  {
+    if (spis2Instance)
+    {
+      spis2Instance->onService();
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+ * SPI Slave library for nRF52.
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _SPI_SLAVE_H_INCLUDED
+#define _SPI_SLAVE_H_INCLUDED
+
+#include <Arduino.h>
+
+#if defined(NRF52_SERIES)
+
+// same encoding as the SPI library
+#ifndef SPI_MODE0
+#define SPI_MODE0 0x02
+#define SPI_MODE1 0x00
+#define SPI_MODE2 0x03
+#define SPI_MODE3 0x01
+#endif
+
+// RXD/TXD MAXCNT is 8 bits wide on the nRF52832
+#ifndef SPI_SLAVE_BUFFER_SIZE
+#define SPI_SLAVE_BUFFER_SIZE 255
+#endif
+
+// The SPIS owns one RX/TX buffer pair while the other one is handed to the
+// application, the semaphore is passed back and forth with ACQUIRE/RELEASE.
+// The next pair is armed in the interrupt before onReceive is called, so the
+// master can clock the next transaction while the last one is processed.
+//
+// SPIS2 is serviced by this library, for SPIS0/SPIS1 the sketch must call
+// onService() from the matching IRQ handler.
+class SPISlave {
+  public:
+  SPISlave(NRF_SPIS_Type *p_spis, IRQn_Type IRQn, uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI, uint8_t uc_pinCS);
+
+  void begin(uint8_t dataMode = SPI_MODE0, BitOrder bitOrder = MSBFIRST);
+  void end();
+
+  // Reply for the master, it is clocked out on the transaction following
+  // the one that is already armed. Returns the number of bytes staged.
+  size_t write(const uint8_t *data, size_t length);
+
+  // Called from the interrupt when a transaction ended (CS released),
+  // data stays valid until the next callback.
+  void onReceive(void(*)(const uint8_t *data, size_t length));
+
+  void onService(void);
+
+  private:
+  void arm();
+
+  NRF_SPIS_Type *_p_spis;
+  IRQn_Type _IRQn;
+
+  uint8_t _uc_pinMiso;
+  uint8_t _uc_pinMosi;
+  uint8_t _uc_pinSCK;
+  uint8_t _uc_pinCS;
+
+  uint8_t _rxBuffer[2][SPI_SLAVE_BUFFER_SIZE];
+  uint8_t _txBuffer[2][SPI_SLAVE_BUFFER_SIZE];
+  volatile size_t _txLength[2];
+
+  // buffer pair owned by the SPIS
+  volatile uint8_t _bank;
+  volatile bool _received;
+  volatile size_t _rxAmount;
+
+  void (*onReceiveCallback)(const uint8_t *, size_t);
+};
+
+#endif
+
+#endif
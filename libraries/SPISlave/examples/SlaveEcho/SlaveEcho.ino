@@ -0,0 +1,35 @@
+// SPI Slave Echo
+//
+// Demonstrates use of the SPISlave library, every frame received from the
+// SPI master is sent back on the next transaction.
+//
+// This example code is in the public domain.
+
+#include <SPISlave.h>
+
+SPISlave spiSlave(NRF_SPIS2, SPIM2_SPIS2_SPI2_IRQn, PIN_SPI_MISO, PIN_SPI_SCK, PIN_SPI_MOSI, SS);
+
+volatile size_t frames = 0;
+
+void setup()
+{
+  Serial.begin(9600);
+
+  spiSlave.onReceive(receiveEvent); // register event
+  spiSlave.begin(SPI_MODE0);
+}
+
+void loop()
+{
+  Serial.print("frames: ");
+  Serial.println(frames);
+  delay(1000);
+}
+
+// function that executes whenever the master releases CS,
+// this function is registered as an event, see setup()
+void receiveEvent(const uint8_t *data, size_t length)
+{
+  spiSlave.write(data, length);
+  frames++;
+}
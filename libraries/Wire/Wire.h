@@ -31,6 +31,32 @@
 // WIRE_HAS_END means Wire has end()
 #define WIRE_HAS_END 1
 
+// WIRE_HAS_ASYNC means Wire has writeAsync(), readAsync() and writeReadAsync()
+#define WIRE_HAS_ASYNC 1
+
+// WIRE_HAS_TIMEOUT means Wire has setWireTimeout(), getWireTimeoutFlag()
+// and clearWireTimeoutFlag()
+#define WIRE_HAS_TIMEOUT 1
+
+// microseconds a transfer may take on top of its time on the wire
+#ifndef WIRE_DEFAULT_TIMEOUT
+#define WIRE_DEFAULT_TIMEOUT 25000
+#endif
+
+#if defined(NRF52_SERIES)
+// largest transfer EasyDMA can do in one go, bounded by the MAXCNT width
+#define WIRE_MAX_TRANSFER_SIZE ((1UL << TWIM0_EASYDMA_MAXCNT_SIZE) - 1)
+// largest setRegisters() region, addressed by a single register select byte
+#define WIRE_MAX_REGISTERS 256
+#else
+// bytes are moved by the TWI interrupt, no hardware limit
+#define WIRE_MAX_TRANSFER_SIZE 0xFFFFUL
+#endif
+
+// Called from the interrupt when an asynchronous transfer completes,
+// status uses the endTransmission() error codes
+typedef void (*TwoWireCallback)(uint8_t status, void *context);
+
 class TwoWire : public Stream
 {
   public:
@@ -45,6 +71,14 @@ class TwoWire : public Stream
     void begin();
 #if defined(NRF52_SERIES)
     void begin(uint8_t);
+    // Register file slave answering on one or two addresses (0 for none).
+    // The first byte a master writes selects the register, reads are served
+    // by EasyDMA straight from the region given to setRegisters() starting
+    // at that register, without calling into the sketch. The pointer moves
+    // past the bytes read. Longer writes land in one half of a double
+    // buffer and are handed to onRegisterWrite() once the master is done,
+    // so the data stays valid until the next write finishes.
+    void beginRegisters(uint8_t address0, uint8_t address1 = 0);
 #endif
     void end();
     void setClock(uint32_t);
@@ -59,15 +93,62 @@ class TwoWire : public Stream
     size_t write(uint8_t data);
     size_t write(const uint8_t * data, size_t quantity);
 
+    // Register read in one transaction: write txData, repeated start, read
+    // rxLength bytes and stop, sequenced by the TWIM shortcuts (nRF52) or the
+    // TWI interrupt (nRF51). Returns the endTransmission() error code.
+    uint8_t writeRead(uint8_t address, const uint8_t * txData, size_t txLength, uint8_t * rxData, size_t rxLength);
+
+    // Blocking transfers straight from/to caller buffers in RAM, up to
+    // WIRE_MAX_TRANSFER_SIZE bytes and without going through txBuffer/rxBuffer.
+    // writeTo() returns the endTransmission() error code (1 if the buffer is
+    // too long or not in RAM), readFrom() the number of bytes read.
+    uint8_t writeTo(uint8_t address, const uint8_t * data, size_t length, bool stopBit = true);
+    size_t readFrom(uint8_t address, uint8_t * data, size_t length, bool stopBit = true);
+
+    // Non-blocking master transfers from/to caller buffers (in RAM, valid
+    // until the callback). Return false if a transfer is already running.
+    bool writeAsync(uint8_t address, const uint8_t * data, size_t length, TwoWireCallback callback, void * context = NULL, bool stopBit = true);
+    bool readAsync(uint8_t address, uint8_t * data, size_t length, TwoWireCallback callback, void * context = NULL, bool stopBit = true);
+    bool writeReadAsync(uint8_t address, const uint8_t * txData, size_t txLength, uint8_t * rxData, size_t rxLength, TwoWireCallback callback, void * context = NULL);
+    // Also aborts a transfer that ran past its timeout, poll it to bound
+    // the duration of asynchronous transfers.
+    bool isBusy(void);
+
+    // Transfers still running timeout microseconds past their expected
+    // duration are aborted with error 5. With resetWithTimeout the bus is
+    // also recovered (9 clocks and a STOP), error 6 means a slave still
+    // holds it low. 0 waits forever.
+    // No timer is armed for it: the deadline is only checked while the
+    // blocking calls wait and when isBusy() or a new transfer is started.
+    // An asynchronous transfer nobody polls stays busy, and its callback
+    // doesn't run, however long the bus hangs.
+    void setWireTimeout(uint32_t timeout = WIRE_DEFAULT_TIMEOUT, bool resetWithTimeout = true);
+    bool getWireTimeoutFlag(void);
+    void clearWireTimeoutFlag(void);
+
+    // Clocks SCL until a slave stuck in the middle of a byte releases SDA,
+    // then sends a STOP. Returns false if the bus is still held low.
+    bool recoverBus(void);
+
     virtual int available(void);
     virtual int read(void);
+    virtual int read(uint8_t * buffer, size_t length);
     virtual int peek(void);
     virtual void flush(void);
 #if defined(NRF52_SERIES)
     void onReceive(void(*)(int));
     void onRequest(void(*)(void));
-    void onService(void);
+
+    // region in RAM served for reads of address, false if it isn't one of
+    // the begin() addresses or EasyDMA can't reach it. At most 256 bytes,
+    // the register select byte is the only pointer and it wraps like an
+    // 8-bit register address.
+    bool setRegisters(uint8_t address, const uint8_t * data, size_t length);
+    // called from the interrupt with the register written and up to
+    // SERIAL_BUFFER_SIZE - 1 data bytes
+    void onRegisterWrite(void(*)(uint8_t address, uint8_t reg, const uint8_t * data, size_t length));
 #endif
+    void onService(void);
 
     using Print::write;
 
@@ -75,10 +156,54 @@ class TwoWire : public Stream
 #if defined(NRF52_SERIES)
     NRF_TWIM_Type * _p_twim;
     NRF_TWIS_Type * _p_twis;
+
+    void onMasterService(void);
+    void beginSlave(uint8_t address0, uint8_t address1);
+    void onRegisterService(void);
+    void finishRegisterWrite(void);
+
+    // register file slave, indexed by the matched TWIS address
+    bool registerMode;
+    const uint8_t * registerData[2];
+    size_t registerLength[2];
+    uint8_t registerPointer[2];
+    uint8_t registerMatch;
+    uint8_t registerBank;
+    bool registerRead;
+    void (*onRegisterWriteCallback)(uint8_t, uint8_t, const uint8_t *, size_t);
 #else
     NRF_TWI_Type * _p_twi;
+
+    void startRx(void);
+
+    // transfer in progress, moved a byte at a time by onService()
+    const uint8_t * txData;
+    size_t txLength;
+    uint8_t * rxData;
+    size_t rxLength;
+    volatile size_t txIndex;
+    volatile size_t rxIndex;
 #endif
 
+    bool validTransfer(const uint8_t * txData, size_t txLength, const uint8_t * rxData, size_t rxLength);
+    bool startTransfer(uint8_t address, const uint8_t * txData, size_t txLength, uint8_t * rxData, size_t rxLength, bool stopBit, TwoWireCallback callback, void * context);
+    uint8_t waitTransfer(void);
+    void checkTimeout(void);
+    void abortTransfer(void);
+    void completeTransfer(void);
+
+    volatile bool busy;
+    volatile uint8_t status;
+    bool stopping;
+    TwoWireCallback callback;
+    void * callbackContext;
+
+    uint32_t clock;
+    uint32_t timeout;
+    bool resetWithTimeout;
+    volatile bool timeoutFlag;
+    uint32_t deadline;
+
     IRQn_Type _IRQn;
 
     uint8_t _uc_pinSDA;
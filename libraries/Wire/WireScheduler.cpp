@@ -0,0 +1,266 @@
+/*
+ * TWI/I2C transaction scheduler for nRF5x
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+extern "C" {
+#include <string.h>
+}
+
+#include <Arduino.h>
+
+#include "WireScheduler.h"
+
+WireScheduler::WireScheduler(TwoWire & wire) :
+  _wire(wire)
+{
+  jobs = NULL;
+  current = NULL;
+  startMicros = 0;
+  windowMark = 0;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void WireScheduler::begin(void)
+{
+  resetStats();
+}
+
+bool WireScheduler::add(WireJob & job)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  for (WireJob * j = jobs; j; j = j->next)
+  {
+    if (j == &job)
+    {
+      __set_PRIMASK(primask);
+      return false;
+    }
+  }
+
+  job.release = millis();
+  job.ready = true;
+  job.missed = 0;
+  job.next = jobs;
+  jobs = &job;
+
+  startNext();
+
+  __set_PRIMASK(primask);
+
+  return true;
+}
+
+void WireScheduler::remove(WireJob & job)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  for (WireJob ** j = &jobs; *j; j = &(*j)->next)
+  {
+    if (*j == &job)
+    {
+      *j = job.next;
+      break;
+    }
+  }
+
+  job.ready = false;
+  job.next = NULL;
+
+  __set_PRIMASK(primask);
+}
+
+void WireScheduler::poll(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  updateWindow();
+  release(millis());
+  startNext();
+
+  __set_PRIMASK(primask);
+}
+
+void WireScheduler::updateWindow(void)
+{
+  uint32_t now = micros();
+
+  stats.windowMicros += now - windowMark;
+  windowMark = now;
+}
+
+void WireScheduler::release(uint32_t now)
+{
+  for (WireJob * job = jobs; job; job = job->next)
+  {
+    if (!job->ready && job != current && (int32_t)(now - job->release) >= 0)
+    {
+      job->ready = true;
+    }
+  }
+}
+
+void WireScheduler::startNext(void)
+{
+  // isBusy() also aborts a transfer that ran past the Wire timeout
+  if (_wire.isBusy() || current)
+  {
+    return;
+  }
+
+  WireJob * best = NULL;
+
+  for (WireJob * job = jobs; job; job = job->next)
+  {
+    if (!job->ready)
+    {
+      continue;
+    }
+
+    if (best == NULL || job->priority > best->priority)
+    {
+      best = job;
+    }
+    else if (job->priority == best->priority && job->deadline)
+    {
+      // earliest deadline first among equal priorities
+      if (!best->deadline || (int32_t)((job->release + job->deadline) - (best->release + best->deadline)) < 0)
+      {
+        best = job;
+      }
+    }
+  }
+
+  if (best == NULL)
+  {
+    return;
+  }
+
+  if (best->deadline && (millis() - best->release) > best->deadline)
+  {
+    best->missed++;
+    stats.deadlineMisses++;
+  }
+
+  best->ready = false;
+  current = best;
+  startMicros = micros();
+
+  bool started;
+
+  if (best->rxLength && best->txLength)
+  {
+    started = _wire.writeReadAsync(best->address, best->txData, best->txLength, best->rxData, best->rxLength, onComplete, this);
+  }
+  else if (best->rxLength)
+  {
+    started = _wire.readAsync(best->address, best->rxData, best->rxLength, onComplete, this);
+  }
+  else
+  {
+    started = _wire.writeAsync(best->address, best->txData, best->txLength, onComplete, this);
+  }
+
+  if (!started)
+  {
+    // bus taken by a direct Wire call, retried on the next poll()
+    best->ready = true;
+    current = NULL;
+  }
+}
+
+void WireScheduler::onComplete(uint8_t status, void * context)
+{
+  WireScheduler * scheduler = (WireScheduler *)context;
+  WireJob * job = scheduler->current;
+  uint32_t now = millis();
+
+  scheduler->stats.busyMicros += micros() - scheduler->startMicros;
+  scheduler->stats.completed++;
+  if (status)
+  {
+    scheduler->stats.errors++;
+  }
+
+  scheduler->current = NULL;
+
+  if (job)
+  {
+    if (job->period)
+    {
+      job->release += job->period;
+
+      // fell more than a period behind, skip the missed releases
+      if ((int32_t)(now - job->release) >= (int32_t)job->period)
+      {
+        job->release = now;
+      }
+    }
+    else
+    {
+      scheduler->remove(*job);
+    }
+
+    if (job->callback)
+    {
+      job->callback(job, status);
+    }
+  }
+
+  scheduler->release(now);
+  scheduler->startNext();
+}
+
+void WireScheduler::getStats(WireSchedulerStats & stats)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  updateWindow();
+  stats = this->stats;
+
+  __set_PRIMASK(primask);
+}
+
+uint8_t WireScheduler::utilization(void)
+{
+  WireSchedulerStats s;
+
+  getStats(s);
+
+  if (s.windowMicros == 0)
+  {
+    return 0;
+  }
+
+  return (uint8_t)((s.busyMicros * 100) / s.windowMicros);
+}
+
+void WireScheduler::resetStats(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  memset(&stats, 0, sizeof(stats));
+  windowMark = micros();
+
+  __set_PRIMASK(primask);
+}
@@ -0,0 +1,102 @@
+/*
+ * TWI/I2C transaction scheduler for nRF5x
+ * Copyright (c) 2026 nRF5 Arduino core contributors.  All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef WireScheduler_h
+#define WireScheduler_h
+
+#include "Wire.h"
+
+class WireScheduler;
+
+// One bus transaction: write txLength bytes then read rxLength bytes (either
+// may be 0). Owned by the sketch and must stay alive while scheduled.
+struct WireJob
+{
+  uint8_t address;
+  const uint8_t * txData;
+  size_t txLength;
+  uint8_t * rxData;
+  size_t rxLength;
+
+  uint32_t period;    // ms between releases, 0 for one shot
+  uint32_t deadline;  // ms after release by which it should have started, 0 for none
+  uint8_t priority;   // higher runs first, ties go to the earliest deadline
+
+  // called from the interrupt, status uses the endTransmission() error codes
+  void (*callback)(WireJob * job, uint8_t status);
+  void * context;
+
+  uint32_t missed;    // deadline misses
+
+  // scheduler state
+  uint32_t release;
+  bool ready;
+  WireJob * next;
+};
+
+struct WireSchedulerStats
+{
+  uint32_t completed;
+  uint32_t errors;
+  uint32_t deadlineMisses;
+  // 64-bit so they don't wrap on long running devices. The window is
+  // accumulated by poll() and getStats(), one of which must run at least
+  // every 71 minutes (the micros() period) for it to stay exact.
+  uint64_t busyMicros;    // time the bus spent in transactions
+  uint64_t windowMicros;  // since begin() or resetStats()
+};
+
+// Runs queued transactions back to back from the Wire interrupt: when one
+// completes the next ready job is started straight away. Periodic jobs are
+// released by poll(), which must be called regularly from loop().
+class WireScheduler
+{
+  public:
+    WireScheduler(TwoWire & wire);
+
+    void begin(void);
+
+    bool add(WireJob & job);
+    void remove(WireJob & job);
+
+    void poll(void);
+
+    void getStats(WireSchedulerStats & stats);
+    // percentage of the stats window the bus was busy
+    uint8_t utilization(void);
+    void resetStats(void);
+
+  private:
+    static void onComplete(uint8_t status, void * context);
+
+    void release(uint32_t now);
+    void updateWindow(void);
+    void startNext(void);
+
+    TwoWire & _wire;
+
+    WireJob * jobs;
+    WireJob * volatile current;
+
+    uint32_t startMicros;
+    uint32_t windowMark;
+    WireSchedulerStats stats;
+};
+
+#endif
@@ -35,10 +35,21 @@ extern "C" {
 TwoWire::TwoWire(NRF_TWI_Type * p_twi, uint8_t pinSDA, uint8_t pinSCL)
 {
   this->_p_twi = p_twi;
+  // each TWI shares its interrupt with the SPI of the same number
+  this->_IRQn = (p_twi == NRF_TWI0) ? SPI0_TWI0_IRQn : SPI1_TWI1_IRQn;
   this->_uc_pinSDA = pinSDA;
   this->_uc_pinSCL = pinSCL;
   this->transmissionBegun = false;
   this->suspended = false;
+  this->busy = false;
+  this->status = 0;
+  this->callback = NULL;
+  this->callbackContext = NULL;
+  this->clock = TWI_CLOCK;
+  this->timeout = WIRE_DEFAULT_TIMEOUT;
+  this->resetWithTimeout = true;
+  this->timeoutFlag = false;
+  this->deadline = 0;
 }
 
 #ifdef ARDUINO_GENERIC
@@ -70,10 +81,21 @@ void TwoWire::begin(void) {
                             | ((uint32_t)GPIO_PIN_CNF_DRIVE_S0D1     << GPIO_PIN_CNF_DRIVE_Pos)
                             | ((uint32_t)GPIO_PIN_CNF_SENSE_Disabled << GPIO_PIN_CNF_SENSE_Pos);
 
+  // a slave reset in the middle of a read may still be holding SDA
+  if (!(portSDA->IN & (1UL << pinSDA)))
+  {
+    recoverBus();
+  }
+
+  clock = TWI_CLOCK;
   _p_twi->FREQUENCY = (TWI_FREQUENCY_FREQUENCY_K100 << TWI_FREQUENCY_FREQUENCY_Pos);
   _p_twi->ENABLE = (TWI_ENABLE_ENABLE_Enabled << TWI_ENABLE_ENABLE_Pos);
   _p_twi->PSELSCL = g_ADigitalPinMap[_uc_pinSCL];
   _p_twi->PSELSDA = g_ADigitalPinMap[_uc_pinSDA];
+
+  NVIC_ClearPendingIRQ(_IRQn);
+  NVIC_SetPriority(_IRQn, 2);
+  NVIC_EnableIRQ(_IRQn);
 }
 
 void TwoWire::setClock(uint32_t baudrate) {
@@ -84,14 +106,17 @@ void TwoWire::setClock(uint32_t baudrate) {
   if (baudrate <= 100000)
   {
     frequency = TWI_FREQUENCY_FREQUENCY_K100;
+    clock = 100000;
   }
   else if (baudrate <= 250000)
   {
     frequency = TWI_FREQUENCY_FREQUENCY_K250;
+    clock = 250000;
   }
   else
   {
     frequency = TWI_FREQUENCY_FREQUENCY_K400;
+    clock = 400000;
   }
 
   _p_twi->FREQUENCY = (frequency << TWI_FREQUENCY_FREQUENCY_Pos);
@@ -102,131 +127,268 @@ void TwoWire::end() {
   _p_twi->ENABLE = (TWI_ENABLE_ENABLE_Disabled << TWI_ENABLE_ENABLE_Pos);
 }
 
-uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit)
+bool TwoWire::validTransfer(const uint8_t * /*txData*/, size_t txLength, const uint8_t * /*rxData*/, size_t rxLength)
 {
-  if (quantity == 0)
+  return txLength <= WIRE_MAX_TRANSFER_SIZE && rxLength <= WIRE_MAX_TRANSFER_SIZE;
+}
+
+bool TwoWire::startTransfer(uint8_t address, const uint8_t * txData, size_t txLength, uint8_t * rxData, size_t rxLength, bool stopBit, TwoWireCallback callback, void * context)
+{
+  checkTimeout();
+
+  if (busy || !validTransfer(txData, txLength, rxData, rxLength))
   {
-    return 0;
+    return false;
   }
-  if (quantity > SERIAL_BUFFER_SIZE)
+
+  busy = true;
+  status = 0;
+  stopping = stopBit || (txLength && rxLength);
+  this->callback = callback;
+  this->callbackContext = context;
+
+  if (timeout)
   {
-    quantity = SERIAL_BUFFER_SIZE;
+    // 9 clocks per byte plus the address, twice with a repeated start
+    deadline = micros() + timeout + (uint32_t)(((uint64_t)(txLength + rxLength + 2) * 9 * 1000000) / clock);
   }
 
-  size_t byteRead = 0;
-  rxBuffer.clear();
+  this->txData = txData;
+  this->txLength = txLength;
+  this->rxData = rxData;
+  this->rxLength = rxLength;
+  txIndex = 0;
+  rxIndex = 0;
 
   _p_twi->ADDRESS = address;
-  _p_twi->SHORTS = 0x1UL;    // To trigger suspend task when a byte is received
 
-  if (!this->suspended) {
-    _p_twi->TASKS_RESUME = 0x1UL;
-    _p_twi->TASKS_STARTRX = 0x1UL;
-  }
+  _p_twi->EVENTS_STOPPED = 0x0UL;
+  _p_twi->EVENTS_ERROR = 0x0UL;
+  _p_twi->EVENTS_SUSPENDED = 0x0UL;
+  _p_twi->EVENTS_TXDSENT = 0x0UL;
+  _p_twi->EVENTS_RXDREADY = 0x0UL;
+
+  _p_twi->INTENSET = TWI_INTENSET_STOPPED_Msk | TWI_INTENSET_ERROR_Msk | TWI_INTENSET_SUSPENDED_Msk |
+                     TWI_INTENSET_TXDSENT_Msk | TWI_INTENSET_RXDREADY_Msk;
 
-  for (byteRead = 0; byteRead < quantity; byteRead++)
+  if (txLength || !rxLength)
   {
-    if (byteRead == quantity - 1)
+    _p_twi->SHORTS = 0x0UL;
+    _p_twi->TASKS_RESUME = 0x1UL;
+    _p_twi->TASKS_STARTTX = 0x1UL;
+
+    if (txLength)
     {
-      // To trigger stop task when last byte is received, set before resume task.
-      if (stopBit) {
-        _p_twi->SHORTS = 0x2UL;
-      }
+      _p_twi->TXD = txData[txIndex++];
+    }
+    else if (stopping)
+    {
+      // address only
+      _p_twi->TASKS_STOP = 0x1UL;
     }
+    else
+    {
+      _p_twi->TASKS_SUSPEND = 0x1UL;
+    }
+  }
+  else
+  {
+    startRx();
+  }
 
-    _p_twi->TASKS_RESUME = 0x1UL;
+  return true;
+}
 
-    while (!_p_twi->EVENTS_RXDREADY && !_p_twi->EVENTS_ERROR);
+void TwoWire::startRx(void)
+{
+  // Suspend on every byte boundary, the byte is only acknowledged once RXD
+  // was read and the TWI resumed. STOP follows the last byte instead.
+  if (rxLength == 1 && stopping)
+  {
+    _p_twi->SHORTS = TWI_SHORTS_BB_STOP_Msk;
+  }
+  else
+  {
+    _p_twi->SHORTS = TWI_SHORTS_BB_SUSPEND_Msk;
+  }
+
+  _p_twi->TASKS_RESUME = 0x1UL;
+
+  if (!this->suspended)
+  {
+    _p_twi->TASKS_STARTRX = 0x1UL;
+  }
+
+  this->suspended = false;
+}
 
-    if (_p_twi->EVENTS_ERROR)
+uint8_t TwoWire::waitTransfer(void)
+{
+  while (busy)
+  {
+    // still pending means the TWI interrupt can't preempt the caller
+    // (interrupts masked or called from an ISR of same or higher priority)
+    if (NVIC_GetPendingIRQ(_IRQn))
     {
-      break;
+      NVIC_ClearPendingIRQ(_IRQn);
+      onService();
     }
 
-    _p_twi->EVENTS_RXDREADY = 0x0UL;
+    checkTimeout();
+  }
+
+  return status;
+}
 
-    rxBuffer.store_char(_p_twi->RXD);
+void TwoWire::checkTimeout(void)
+{
+  if (!busy || !timeout || (int32_t)(micros() - deadline) < 0)
+  {
+    return;
   }
 
-  if (stopBit || _p_twi->EVENTS_ERROR)
+  NVIC_DisableIRQ(_IRQn);
+
+  // completed in the meantime, but not serviced yet
+  if (NVIC_GetPendingIRQ(_IRQn))
   {
-    this->suspended = false;
-    _p_twi->TASKS_STOP = 0x1UL;
-    while(!_p_twi->EVENTS_STOPPED);
-    _p_twi->EVENTS_STOPPED = 0x0UL;
+    NVIC_ClearPendingIRQ(_IRQn);
+    onService();
   }
-  else
+
+  if (busy)
   {
-    this->suspended = true;
-    _p_twi->TASKS_SUSPEND = 0x1UL;
-    while(!_p_twi->EVENTS_SUSPENDED);
-    _p_twi->EVENTS_SUSPENDED = 0x0UL;
+    abortTransfer();
   }
 
-  if (_p_twi->EVENTS_ERROR)
+  NVIC_EnableIRQ(_IRQn);
+}
+
+void TwoWire::abortTransfer(void)
+{
+  _p_twi->INTENCLR = TWI_INTENCLR_STOPPED_Msk | TWI_INTENCLR_ERROR_Msk | TWI_INTENCLR_SUSPENDED_Msk |
+                     TWI_INTENCLR_TXDSENT_Msk | TWI_INTENCLR_RXDREADY_Msk;
+  _p_twi->SHORTS = 0x0UL;
+
+  // STOP never completes while a slave holds SDA, disabling the TWI
+  // releases the lines whatever state it is in
+  _p_twi->TASKS_STOP = 0x1UL;
+  _p_twi->ENABLE = (TWI_ENABLE_ENABLE_Disabled << TWI_ENABLE_ENABLE_Pos);
+
+  this->suspended = false;
+  status = 5;
+
+  if (resetWithTimeout && !recoverBus())
   {
-    _p_twi->EVENTS_ERROR = 0x0UL;
+    status = 6;
   }
 
-  return byteRead;
+  _p_twi->EVENTS_STOPPED = 0x0UL;
+  _p_twi->EVENTS_ERROR = 0x0UL;
+  _p_twi->EVENTS_SUSPENDED = 0x0UL;
+  _p_twi->EVENTS_TXDSENT = 0x0UL;
+  _p_twi->EVENTS_RXDREADY = 0x0UL;
+
+  _p_twi->ENABLE = (TWI_ENABLE_ENABLE_Enabled << TWI_ENABLE_ENABLE_Pos);
+
+  timeoutFlag = true;
+
+  completeTransfer();
 }
 
-uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity)
+void TwoWire::completeTransfer(void)
 {
-  return requestFrom(address, quantity, true);
+  _p_twi->INTENCLR = TWI_INTENCLR_STOPPED_Msk | TWI_INTENCLR_ERROR_Msk | TWI_INTENCLR_SUSPENDED_Msk |
+                     TWI_INTENCLR_TXDSENT_Msk | TWI_INTENCLR_RXDREADY_Msk;
+  _p_twi->SHORTS = 0x0UL;
+
+  TwoWireCallback function = callback;
+  void * context = callbackContext;
+
+  busy = false;
+
+  if (function)
+  {
+    function(status, context);
+  }
 }
 
-void TwoWire::beginTransmission(uint8_t address) {
-  // save address of target and clear buffer
-  txAddress = address;
-  txBuffer.clear();
+bool TwoWire::isBusy(void)
+{
+  checkTimeout();
 
-  transmissionBegun = true;
+  return busy;
 }
 
-// Errors:
-//  0 : Success
-//  1 : Data too long
-//  2 : NACK on transmit of address
-//  3 : NACK on transmit of data
-//  4 : Other error
-uint8_t TwoWire::endTransmission(bool stopBit)
+void TwoWire::setWireTimeout(uint32_t timeout, bool resetWithTimeout)
 {
-  transmissionBegun = false;
+  this->timeout = timeout;
+  this->resetWithTimeout = resetWithTimeout;
+}
 
-  // Start I2C transmission
-  _p_twi->ADDRESS = txAddress;
-  _p_twi->SHORTS = 0x0UL;
-  _p_twi->TASKS_RESUME = 0x1UL;
-  _p_twi->TASKS_STARTTX = 0x1UL;
+bool TwoWire::getWireTimeoutFlag(void)
+{
+  return timeoutFlag;
+}
 
-  while (txBuffer.available())
-  {
-    _p_twi->TXD = txBuffer.read_char();
+void TwoWire::clearWireTimeoutFlag(void)
+{
+  timeoutFlag = false;
+}
 
-    while(!_p_twi->EVENTS_TXDSENT && !_p_twi->EVENTS_ERROR);
+bool TwoWire::recoverBus(void)
+{
+  NRF_GPIO_Type* portSCL = digitalPinToPort(_uc_pinSCL);
+  NRF_GPIO_Type* portSDA = digitalPinToPort(_uc_pinSDA);
+  uint32_t pinSCL = digitalPinToPin(_uc_pinSCL);
+  uint32_t pinSDA = digitalPinToPin(_uc_pinSDA);
 
-    if (_p_twi->EVENTS_ERROR)
-    {
-      break;
-    }
+  // the pins go back to GPIO control while the TWI is disabled
+  uint32_t enable = _p_twi->ENABLE;
 
-    _p_twi->EVENTS_TXDSENT = 0x0UL;
-  }
+  _p_twi->ENABLE = (TWI_ENABLE_ENABLE_Disabled << TWI_ENABLE_ENABLE_Pos);
 
-  if (stopBit || _p_twi->EVENTS_ERROR)
-  {
-    _p_twi->TASKS_STOP = 0x1UL;
-    while(!_p_twi->EVENTS_STOPPED);
-    _p_twi->EVENTS_STOPPED = 0x0UL;
-  }
-  else
+  uint32_t input = portSCL->PIN_CNF[pinSCL];
+  uint32_t output = (input & ~GPIO_PIN_CNF_DIR_Msk) | ((uint32_t)GPIO_PIN_CNF_DIR_Output << GPIO_PIN_CNF_DIR_Pos);
+
+  portSCL->OUTSET = (1UL << pinSCL);
+  portSDA->OUTSET = (1UL << pinSDA);
+  portSCL->PIN_CNF[pinSCL] = output;
+
+  // up to 9 clocks until the slave has shifted out the rest of its byte
+  for (int i = 0; i < 9 && !(portSDA->IN & (1UL << pinSDA)); i++)
   {
-    _p_twi->TASKS_SUSPEND = 0x1UL;
-    while(!_p_twi->EVENTS_SUSPENDED);
-    _p_twi->EVENTS_SUSPENDED = 0x0UL;
+    portSCL->OUTCLR = (1UL << pinSCL);
+    delayMicroseconds(5);
+    portSCL->OUTSET = (1UL << pinSCL);
+    delayMicroseconds(5);
   }
 
+  // STOP: SDA rises while SCL is high
+  portSCL->OUTCLR = (1UL << pinSCL);
+  delayMicroseconds(5);
+  portSDA->OUTCLR = (1UL << pinSDA);
+  portSDA->PIN_CNF[pinSDA] = output;
+  delayMicroseconds(5);
+  portSCL->OUTSET = (1UL << pinSCL);
+  delayMicroseconds(5);
+  portSDA->OUTSET = (1UL << pinSDA);
+  delayMicroseconds(5);
+
+  portSCL->PIN_CNF[pinSCL] = input;
+  portSDA->PIN_CNF[pinSDA] = input;
+
+  bool released = (portSCL->IN & (1UL << pinSCL)) && (portSDA->IN & (1UL << pinSDA));
+
+  _p_twi->ENABLE = enable;
+
+  return released;
+}
+
+void TwoWire::onService(void)
+{
+  bool done = false;
+
   if (_p_twi->EVENTS_ERROR)
   {
     _p_twi->EVENTS_ERROR = 0x0UL;
@@ -237,19 +399,228 @@ uint8_t TwoWire::endTransmission(bool stopBit)
 
     if (error == TWI_ERRORSRC_ANACK_Msk)
     {
-      return 2;
+      status = 2;
     }
     else if (error == TWI_ERRORSRC_DNACK_Msk)
     {
-      return 3;
+      status = 3;
+    }
+    else
+    {
+      status = 4;
+    }
+
+    // always release the bus after an error
+    this->suspended = false;
+    stopping = true;
+    _p_twi->SHORTS = 0x0UL;
+    _p_twi->TASKS_RESUME = 0x1UL;
+    _p_twi->TASKS_STOP = 0x1UL;
+  }
+
+  if (_p_twi->EVENTS_TXDSENT)
+  {
+    _p_twi->EVENTS_TXDSENT = 0x0UL;
+
+    if (status)
+    {
+      // waiting for STOPPED
+    }
+    else if (txIndex < txLength)
+    {
+      _p_twi->TXD = txData[txIndex++];
+    }
+    else if (rxLength)
+    {
+      // repeated start
+      startRx();
+    }
+    else if (stopping)
+    {
+      _p_twi->TASKS_STOP = 0x1UL;
     }
     else
     {
-      return 4;
+      _p_twi->TASKS_SUSPEND = 0x1UL;
+    }
+  }
+
+  if (_p_twi->EVENTS_RXDREADY)
+  {
+    _p_twi->EVENTS_RXDREADY = 0x0UL;
+
+    if (rxIndex < rxLength)
+    {
+      rxData[rxIndex++] = _p_twi->RXD;
     }
+
+    if (status)
+    {
+      // waiting for STOPPED
+    }
+    else if (rxIndex < rxLength)
+    {
+      if (rxIndex == rxLength - 1 && stopping)
+      {
+        // To trigger stop task when last byte is received, set before resume task.
+        _p_twi->SHORTS = TWI_SHORTS_BB_STOP_Msk;
+      }
+
+      _p_twi->TASKS_RESUME = 0x1UL;
+    }
+    else if (!stopping)
+    {
+      // held on the byte boundary, the next requestFrom() resumes from here
+      this->suspended = true;
+      done = true;
+    }
+  }
+
+  if (_p_twi->EVENTS_STOPPED)
+  {
+    _p_twi->EVENTS_STOPPED = 0x0UL;
+    done = true;
+  }
+
+  if (_p_twi->EVENTS_SUSPENDED)
+  {
+    _p_twi->EVENTS_SUSPENDED = 0x0UL;
+
+    // only the end of a write without stop, reads suspend on every byte
+    done |= !stopping && !rxLength;
+  }
+
+  if (done && busy)
+  {
+    completeTransfer();
+  }
+}
+
+bool TwoWire::writeAsync(uint8_t address, const uint8_t * data, size_t length, TwoWireCallback callback, void * context, bool stopBit)
+{
+  return startTransfer(address, data, length, NULL, 0, stopBit, callback, context);
+}
+
+bool TwoWire::readAsync(uint8_t address, uint8_t * data, size_t length, TwoWireCallback callback, void * context, bool stopBit)
+{
+  if (length == 0)
+  {
+    return false;
+  }
+
+  return startTransfer(address, NULL, 0, data, length, stopBit, callback, context);
+}
+
+bool TwoWire::writeReadAsync(uint8_t address, const uint8_t * txData, size_t txLength, uint8_t * rxData, size_t rxLength, TwoWireCallback callback, void * context)
+{
+  if (rxLength == 0)
+  {
+    return false;
+  }
+
+  return startTransfer(address, txData, txLength, rxData, rxLength, true, callback, context);
+}
+
+uint8_t TwoWire::writeRead(uint8_t address, const uint8_t * txData, size_t txLength, uint8_t * rxData, size_t rxLength)
+{
+  if (!validTransfer(txData, txLength, rxData, rxLength))
+  {
+    return 1;
+  }
+
+  if (!startTransfer(address, txData, txLength, rxData, rxLength, true, NULL, NULL))
+  {
+    return 4;
+  }
+
+  return waitTransfer();
+}
+
+uint8_t TwoWire::writeTo(uint8_t address, const uint8_t * data, size_t length, bool stopBit)
+{
+  if (!validTransfer(data, length, NULL, 0))
+  {
+    return 1;
+  }
+
+  if (!startTransfer(address, data, length, NULL, 0, stopBit, NULL, NULL))
+  {
+    return 4;
   }
 
-  return 0;
+  return waitTransfer();
+}
+
+size_t TwoWire::readFrom(uint8_t address, uint8_t * data, size_t length, bool stopBit)
+{
+  if (length == 0 || !startTransfer(address, NULL, 0, data, length, stopBit, NULL, NULL))
+  {
+    return 0;
+  }
+
+  if (waitTransfer())
+  {
+    return 0;
+  }
+
+  return rxIndex;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit)
+{
+  if (quantity == 0)
+  {
+    return 0;
+  }
+  // one slot of the ring buffer always stays free
+  if (quantity > SERIAL_BUFFER_SIZE - 1)
+  {
+    quantity = SERIAL_BUFFER_SIZE - 1;
+  }
+
+  rxBuffer.clear();
+
+  if (!startTransfer(address, NULL, 0, rxBuffer._aucBuffer, quantity, stopBit, NULL, NULL))
+  {
+    return 0;
+  }
+
+  waitTransfer();
+
+  return rxBuffer._iHead = rxIndex;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity)
+{
+  return requestFrom(address, quantity, true);
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  // save address of target and clear buffer
+  txAddress = address;
+  txBuffer.clear();
+
+  transmissionBegun = true;
+}
+
+// Errors:
+//  0 : Success
+//  1 : Data too long
+//  2 : NACK on transmit of address
+//  3 : NACK on transmit of data
+//  4 : Other error
+//  5 : Timeout
+//  6 : Timeout, bus recovery failed
+uint8_t TwoWire::endTransmission(bool stopBit)
+{
+  transmissionBegun = false;
+
+  if (!startTransfer(txAddress, txBuffer._aucBuffer, txBuffer.available(), NULL, 0, stopBit, NULL, NULL))
+  {
+    return 4;
+  }
+
+  return waitTransfer();
 }
 
 uint8_t TwoWire::endTransmission()
@@ -272,16 +643,13 @@ size_t TwoWire::write(uint8_t ucData)
 
 size_t TwoWire::write(const uint8_t *data, size_t quantity)
 {
-  //Try to store all data
-  for(size_t i = 0; i < quantity; ++i)
+  if ( !transmissionBegun )
   {
-    //Return the number of data stored, when the buffer is full (if write return 0)
-    if(!write(data[i]))
-      return i;
+    return 0 ;
   }
 
-  //All data stored
-  return quantity;
+  //Return the number of data stored, up to a full buffer
+  return txBuffer.store_chars( data, quantity ) ;
 }
 
 int TwoWire::available(void)
@@ -294,6 +662,11 @@ int TwoWire::read(void)
   return rxBuffer.read_char();
 }
 
+int TwoWire::read(uint8_t * buffer, size_t length)
+{
+  return rxBuffer.read_chars(buffer, length);
+}
+
 int TwoWire::peek(void)
 {
   return rxBuffer.peek();
@@ -307,10 +680,26 @@ void TwoWire::flush(void)
 
 #if WIRE_INTERFACES_COUNT > 0
 TwoWire Wire(NRF_TWI1, PIN_WIRE_SDA, PIN_WIRE_SCL);
+
+extern "C"
+{
+  void SPI1_TWI1_IRQHandler(void)
+  {
+    Wire.onService();
+  }
+}
 #endif
 
 #if WIRE_INTERFACES_COUNT > 1
 TwoWire Wire1(NRF_TWI0, PIN_WIRE1_SDA, PIN_WIRE1_SCL);
+
+extern "C"
+{
+  void SPI0_TWI0_IRQHandler(void)
+  {
+    Wire1.onService();
+  }
+}
 #endif
 
 #endif
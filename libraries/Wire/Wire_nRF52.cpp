@@ -39,6 +39,23 @@ TwoWire::TwoWire(NRF_TWIM_Type * p_twim, NRF_TWIS_Type * p_twis, IRQn_Type IRQn,
   this->_uc_pinSDA = pinSDA;
   this->_uc_pinSCL = pinSCL;
   transmissionBegun = false;
+  busy = false;
+  status = 0;
+  callback = NULL;
+  callbackContext = NULL;
+  clock = TWI_CLOCK;
+  timeout = WIRE_DEFAULT_TIMEOUT;
+  resetWithTimeout = true;
+  timeoutFlag = false;
+  deadline = 0;
+  registerMode = false;
+  registerData[0] = registerData[1] = NULL;
+  registerLength[0] = registerLength[1] = 0;
+  registerPointer[0] = registerPointer[1] = 0;
+  registerMatch = 0;
+  registerBank = 0;
+  registerRead = false;
+  onRegisterWriteCallback = NULL;
 }
 
 #ifdef ARDUINO_GENERIC
@@ -70,6 +87,13 @@ void TwoWire::begin(void) {
                             | ((uint32_t)GPIO_PIN_CNF_DRIVE_S0D1     << GPIO_PIN_CNF_DRIVE_Pos)
                             | ((uint32_t)GPIO_PIN_CNF_SENSE_Disabled << GPIO_PIN_CNF_SENSE_Pos);
 
+  // a slave reset in the middle of a read may still be holding SDA
+  if (!(portSDA->IN & (1UL << pinSDA)))
+  {
+    recoverBus();
+  }
+
+  clock = TWI_CLOCK;
   _p_twim->FREQUENCY = TWIM_FREQUENCY_FREQUENCY_K100;
   _p_twim->ENABLE = (TWIM_ENABLE_ENABLE_Enabled << TWIM_ENABLE_ENABLE_Pos);
   _p_twim->PSEL.SCL = g_ADigitalPinMap[_uc_pinSCL];
@@ -81,6 +105,20 @@ void TwoWire::begin(void) {
 }
 
 void TwoWire::begin(uint8_t address) {
+  registerMode = false;
+
+  beginSlave(address, 0);
+}
+
+void TwoWire::beginRegisters(uint8_t address0, uint8_t address1) {
+  registerMode = true;
+  registerPointer[0] = registerPointer[1] = 0;
+  registerBank = 0;
+
+  beginSlave(address0, address1);
+}
+
+void TwoWire::beginSlave(uint8_t address0, uint8_t address1) {
   //Slave mode
   master = false;
 
@@ -96,8 +134,9 @@ void TwoWire::begin(uint8_t address) {
                                 | ((uint32_t)GPIO_PIN_CNF_DRIVE_S0S1       << GPIO_PIN_CNF_DRIVE_Pos)
                                 | ((uint32_t)GPIO_PIN_CNF_SENSE_Disabled   << GPIO_PIN_CNF_SENSE_Pos);
 
-  _p_twis->ADDRESS[0] = address;
-  _p_twis->CONFIG = TWIS_CONFIG_ADDRESS0_Msk;
+  _p_twis->ADDRESS[0] = address0;
+  _p_twis->ADDRESS[1] = address1;
+  _p_twis->CONFIG = TWIS_CONFIG_ADDRESS0_Msk | (address1 ? TWIS_CONFIG_ADDRESS1_Msk : 0);
   _p_twis->PSEL.SCL = g_ADigitalPinMap[_uc_pinSCL];
   _p_twis->PSEL.SDA = g_ADigitalPinMap[_uc_pinSDA];
 
@@ -121,14 +160,17 @@ void TwoWire::setClock(uint32_t baudrate) {
     if (baudrate <= 100000)
     {
       frequency = TWIM_FREQUENCY_FREQUENCY_K100;
+      clock = 100000;
     }
     else if (baudrate <= 250000)
     {
       frequency = TWIM_FREQUENCY_FREQUENCY_K250;
+      clock = 250000;
     }
     else
     {
       frequency = TWIM_FREQUENCY_FREQUENCY_K400;
+      clock = 400000;
     }
 
     _p_twim->FREQUENCY = frequency;
@@ -147,129 +189,399 @@ void TwoWire::end() {
   }
 }
 
-uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit)
+static inline bool isRamBuffer(const uint8_t * buffer, size_t length)
 {
-  if(quantity == 0)
+  // EasyDMA can only access Data RAM
+  return length == 0 || ((uint32_t)buffer & 0xE0000000UL) == 0x20000000UL;
+}
+
+bool TwoWire::validTransfer(const uint8_t * txData, size_t txLength, const uint8_t * rxData, size_t rxLength)
+{
+  return txLength <= WIRE_MAX_TRANSFER_SIZE && rxLength <= WIRE_MAX_TRANSFER_SIZE &&
+         isRamBuffer(txData, txLength) && isRamBuffer(rxData, rxLength);
+}
+
+bool TwoWire::startTransfer(uint8_t address, const uint8_t * txData, size_t txLength, uint8_t * rxData, size_t rxLength, bool stopBit, TwoWireCallback callback, void * context)
+{
+  checkTimeout();
+
+  if (busy || !validTransfer(txData, txLength, rxData, rxLength))
   {
-    return 0;
+    return false;
   }
 
-  size_t byteRead = 0;
-  rxBuffer.clear();
+  busy = true;
+  status = 0;
+  stopping = stopBit;
+  this->callback = callback;
+  this->callbackContext = context;
+
+  if (timeout)
+  {
+    // 9 clocks per byte plus the address, twice with a repeated start
+    deadline = micros() + timeout + (uint32_t)(((uint64_t)(txLength + rxLength + 2) * 9 * 1000000) / clock);
+  }
+
+  uint32_t shorts = 0;
+  uint32_t inten = TWIM_INTEN_STOPPED_Msk | TWIM_INTEN_ERROR_Msk;
+
+  if (txLength && rxLength)
+  {
+    // repeated start handled by the TWIM, one interrupt at the end
+    shorts = TWIM_SHORTS_LASTTX_STARTRX_Msk | TWIM_SHORTS_LASTRX_STOP_Msk;
+    stopping = true;
+  }
+  else if (rxLength)
+  {
+    if (stopBit)
+    {
+      shorts = TWIM_SHORTS_LASTRX_STOP_Msk;
+    }
+    else
+    {
+      inten |= TWIM_INTEN_LASTRX_Msk | TWIM_INTEN_SUSPENDED_Msk;
+    }
+  }
+  else if (txLength)
+  {
+    if (stopBit)
+    {
+      shorts = TWIM_SHORTS_LASTTX_STOP_Msk;
+    }
+    else
+    {
+      shorts = TWIM_SHORTS_LASTTX_SUSPEND_Msk;
+      inten |= TWIM_INTEN_SUSPENDED_Msk;
+    }
+  }
+  else
+  {
+    // address only, there is no LASTTX to hook a short on
+    inten |= TWIM_INTEN_TXSTARTED_Msk | TWIM_INTEN_SUSPENDED_Msk;
+  }
 
   _p_twim->ADDRESS = address;
 
-  _p_twim->TASKS_RESUME = 0x1UL;
-  _p_twim->RXD.PTR = (uint32_t)rxBuffer._aucBuffer;
-  _p_twim->RXD.MAXCNT = quantity;
-  _p_twim->TASKS_STARTRX = 0x1UL;
+  _p_twim->TXD.PTR = (uint32_t)txData;
+  _p_twim->TXD.MAXCNT = txLength;
+  _p_twim->RXD.PTR = (uint32_t)rxData;
+  _p_twim->RXD.MAXCNT = rxLength;
 
-  while(!_p_twim->EVENTS_RXSTARTED && !_p_twim->EVENTS_ERROR);
+  _p_twim->EVENTS_STOPPED = 0x0UL;
+  _p_twim->EVENTS_ERROR = 0x0UL;
+  _p_twim->EVENTS_SUSPENDED = 0x0UL;
+  _p_twim->EVENTS_TXSTARTED = 0x0UL;
   _p_twim->EVENTS_RXSTARTED = 0x0UL;
-
-  while(!_p_twim->EVENTS_LASTRX && !_p_twim->EVENTS_ERROR);
+  _p_twim->EVENTS_LASTTX = 0x0UL;
   _p_twim->EVENTS_LASTRX = 0x0UL;
 
-  if (stopBit || _p_twim->EVENTS_ERROR)
+  _p_twim->SHORTS = shorts;
+  _p_twim->INTEN = inten;
+
+  _p_twim->TASKS_RESUME = 0x1UL;
+
+  if (txLength || !rxLength)
   {
-    _p_twim->TASKS_STOP = 0x1UL;
-    while(!_p_twim->EVENTS_STOPPED);
-    _p_twim->EVENTS_STOPPED = 0x0UL;
+    _p_twim->TASKS_STARTTX = 0x1UL;
   }
   else
   {
-    _p_twim->TASKS_SUSPEND = 0x1UL;
-    while(!_p_twim->EVENTS_SUSPENDED);
-    _p_twim->EVENTS_SUSPENDED = 0x0UL;
+    _p_twim->TASKS_STARTRX = 0x1UL;
   }
 
-  if (_p_twim->EVENTS_ERROR)
+  return true;
+}
+
+uint8_t TwoWire::waitTransfer(void)
+{
+  while (busy)
   {
-    _p_twim->EVENTS_ERROR = 0x0UL;
+    // still pending means the TWIM interrupt can't preempt the caller
+    // (interrupts masked or called from an ISR of same or higher priority)
+    if (NVIC_GetPendingIRQ(_IRQn))
+    {
+      NVIC_ClearPendingIRQ(_IRQn);
+      onService();
+    }
+
+    checkTimeout();
+  }
+
+  return status;
+}
+
+void TwoWire::checkTimeout(void)
+{
+  if (!busy || !timeout || (int32_t)(micros() - deadline) < 0)
+  {
+    return;
   }
 
-  byteRead = rxBuffer._iHead = _p_twim->RXD.AMOUNT;
+  NVIC_DisableIRQ(_IRQn);
+
+  // completed in the meantime, but not serviced yet
+  if (NVIC_GetPendingIRQ(_IRQn))
+  {
+    NVIC_ClearPendingIRQ(_IRQn);
+    onService();
+  }
 
-  return byteRead;
+  if (busy)
+  {
+    abortTransfer();
+  }
+
+  NVIC_EnableIRQ(_IRQn);
 }
 
-uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity)
+void TwoWire::abortTransfer(void)
 {
-  return requestFrom(address, quantity, true);
+  _p_twim->INTEN = 0;
+  _p_twim->SHORTS = 0;
+
+  // STOP never completes while a slave holds SDA, disabling the TWIM
+  // releases the lines whatever state it is in
+  _p_twim->TASKS_STOP = 0x1UL;
+  _p_twim->ENABLE = (TWIM_ENABLE_ENABLE_Disabled << TWIM_ENABLE_ENABLE_Pos);
+
+  status = 5;
+
+  if (resetWithTimeout && !recoverBus())
+  {
+    status = 6;
+  }
+
+  _p_twim->EVENTS_STOPPED = 0x0UL;
+  _p_twim->EVENTS_ERROR = 0x0UL;
+  _p_twim->EVENTS_SUSPENDED = 0x0UL;
+  _p_twim->EVENTS_TXSTARTED = 0x0UL;
+  _p_twim->EVENTS_LASTRX = 0x0UL;
+
+  _p_twim->ENABLE = (TWIM_ENABLE_ENABLE_Enabled << TWIM_ENABLE_ENABLE_Pos);
+
+  timeoutFlag = true;
+
+  completeTransfer();
 }
 
-void TwoWire::beginTransmission(uint8_t address) {
-  // save address of target and clear buffer
-  txAddress = address;
-  txBuffer.clear();
+void TwoWire::completeTransfer(void)
+{
+  _p_twim->INTEN = 0;
+  _p_twim->SHORTS = 0;
 
-  transmissionBegun = true;
+  TwoWireCallback function = callback;
+  void * context = callbackContext;
+
+  busy = false;
+
+  if (function)
+  {
+    function(status, context);
+  }
 }
 
-// Errors:
-//  0 : Success
-//  1 : Data too long
-//  2 : NACK on transmit of address
-//  3 : NACK on transmit of data
-//  4 : Other error
-uint8_t TwoWire::endTransmission(bool stopBit)
+bool TwoWire::isBusy(void)
 {
-  transmissionBegun = false ;
+  checkTimeout();
 
-  // Start I2C transmission
-  _p_twim->ADDRESS = txAddress;
+  return busy;
+}
 
-  _p_twim->TASKS_RESUME = 0x1UL;
+void TwoWire::setWireTimeout(uint32_t timeout, bool resetWithTimeout)
+{
+  this->timeout = timeout;
+  this->resetWithTimeout = resetWithTimeout;
+}
 
-  _p_twim->TXD.PTR = (uint32_t)txBuffer._aucBuffer;
-  _p_twim->TXD.MAXCNT = txBuffer.available();
+bool TwoWire::getWireTimeoutFlag(void)
+{
+  return timeoutFlag;
+}
 
-  _p_twim->TASKS_STARTTX = 0x1UL;
+void TwoWire::clearWireTimeoutFlag(void)
+{
+  timeoutFlag = false;
+}
 
-  while(!_p_twim->EVENTS_TXSTARTED && !_p_twim->EVENTS_ERROR);
-  _p_twim->EVENTS_TXSTARTED = 0x0UL;
+bool TwoWire::recoverBus(void)
+{
+  if (!master)
+  {
+    return false;
+  }
 
-  if (txBuffer.available()) {
-    while(!_p_twim->EVENTS_LASTTX && !_p_twim->EVENTS_ERROR);
+  NRF_GPIO_Type* portSCL = digitalPinToPort(_uc_pinSCL);
+  NRF_GPIO_Type* portSDA = digitalPinToPort(_uc_pinSDA);
+  uint32_t pinSCL = digitalPinToPin(_uc_pinSCL);
+  uint32_t pinSDA = digitalPinToPin(_uc_pinSDA);
+
+  // the pins go back to GPIO control while the TWIM is disabled
+  uint32_t enable = _p_twim->ENABLE;
+
+  _p_twim->ENABLE = (TWIM_ENABLE_ENABLE_Disabled << TWIM_ENABLE_ENABLE_Pos);
+
+  uint32_t input = portSCL->PIN_CNF[pinSCL];
+  uint32_t output = (input & ~GPIO_PIN_CNF_DIR_Msk) | ((uint32_t)GPIO_PIN_CNF_DIR_Output << GPIO_PIN_CNF_DIR_Pos);
+
+  portSCL->OUTSET = (1UL << pinSCL);
+  portSDA->OUTSET = (1UL << pinSDA);
+  portSCL->PIN_CNF[pinSCL] = output;
+
+  // up to 9 clocks until the slave has shifted out the rest of its byte
+  for (int i = 0; i < 9 && !(portSDA->IN & (1UL << pinSDA)); i++)
+  {
+    portSCL->OUTCLR = (1UL << pinSCL);
+    delayMicroseconds(5);
+    portSCL->OUTSET = (1UL << pinSCL);
+    delayMicroseconds(5);
   }
-  _p_twim->EVENTS_LASTTX = 0x0UL;
 
-  if (stopBit || _p_twim->EVENTS_ERROR)
+  // STOP: SDA rises while SCL is high
+  portSCL->OUTCLR = (1UL << pinSCL);
+  delayMicroseconds(5);
+  portSDA->OUTCLR = (1UL << pinSDA);
+  portSDA->PIN_CNF[pinSDA] = output;
+  delayMicroseconds(5);
+  portSCL->OUTSET = (1UL << pinSCL);
+  delayMicroseconds(5);
+  portSDA->OUTSET = (1UL << pinSDA);
+  delayMicroseconds(5);
+
+  portSCL->PIN_CNF[pinSCL] = input;
+  portSDA->PIN_CNF[pinSDA] = input;
+
+  bool released = (portSCL->IN & (1UL << pinSCL)) && (portSDA->IN & (1UL << pinSDA));
+
+  _p_twim->ENABLE = enable;
+
+  return released;
+}
+
+bool TwoWire::writeAsync(uint8_t address, const uint8_t * data, size_t length, TwoWireCallback callback, void * context, bool stopBit)
+{
+  return startTransfer(address, data, length, NULL, 0, stopBit, callback, context);
+}
+
+bool TwoWire::readAsync(uint8_t address, uint8_t * data, size_t length, TwoWireCallback callback, void * context, bool stopBit)
+{
+  if (length == 0)
   {
-    _p_twim->TASKS_STOP = 0x1UL;
-    while(!_p_twim->EVENTS_STOPPED);
-    _p_twim->EVENTS_STOPPED = 0x0UL;
+    return false;
   }
-  else
+
+  return startTransfer(address, NULL, 0, data, length, stopBit, callback, context);
+}
+
+bool TwoWire::writeReadAsync(uint8_t address, const uint8_t * txData, size_t txLength, uint8_t * rxData, size_t rxLength, TwoWireCallback callback, void * context)
+{
+  if (rxLength == 0)
   {
-    _p_twim->TASKS_SUSPEND = 0x1UL;
-    while(!_p_twim->EVENTS_SUSPENDED);
-    _p_twim->EVENTS_SUSPENDED = 0x0UL;
+    return false;
   }
 
-  if (_p_twim->EVENTS_ERROR)
+  return startTransfer(address, txData, txLength, rxData, rxLength, true, callback, context);
+}
+
+uint8_t TwoWire::writeRead(uint8_t address, const uint8_t * txData, size_t txLength, uint8_t * rxData, size_t rxLength)
+{
+  if (!validTransfer(txData, txLength, rxData, rxLength))
   {
-    _p_twim->EVENTS_ERROR = 0x0UL;
+    return 1;
+  }
 
-    uint32_t error = _p_twim->ERRORSRC;
+  if (!startTransfer(address, txData, txLength, rxData, rxLength, true, NULL, NULL))
+  {
+    return 4;
+  }
 
-    _p_twim->ERRORSRC = error;
+  return waitTransfer();
+}
 
-    if (error == TWIM_ERRORSRC_ANACK_Msk)
-    {
-      return 2;
-    }
-    else if (error == TWIM_ERRORSRC_DNACK_Msk)
-    {
-      return 3;
-    }
-    else
-    {
-      return 4;
-    }
+uint8_t TwoWire::writeTo(uint8_t address, const uint8_t * data, size_t length, bool stopBit)
+{
+  if (!validTransfer(data, length, NULL, 0))
+  {
+    return 1;
+  }
+
+  if (!startTransfer(address, data, length, NULL, 0, stopBit, NULL, NULL))
+  {
+    return 4;
   }
 
-  return 0;
+  return waitTransfer();
+}
+
+size_t TwoWire::readFrom(uint8_t address, uint8_t * data, size_t length, bool stopBit)
+{
+  if (length == 0 || !startTransfer(address, NULL, 0, data, length, stopBit, NULL, NULL))
+  {
+    return 0;
+  }
+
+  if (waitTransfer())
+  {
+    return 0;
+  }
+
+  return _p_twim->RXD.AMOUNT;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit)
+{
+  if(quantity == 0)
+  {
+    return 0;
+  }
+  // one slot of the ring buffer always stays free
+  if (quantity > SERIAL_BUFFER_SIZE - 1)
+  {
+    quantity = SERIAL_BUFFER_SIZE - 1;
+  }
+
+  rxBuffer.clear();
+
+  if (!startTransfer(address, NULL, 0, rxBuffer._aucBuffer, quantity, stopBit, NULL, NULL))
+  {
+    return 0;
+  }
+
+  waitTransfer();
+
+  return rxBuffer._iHead = _p_twim->RXD.AMOUNT;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity)
+{
+  return requestFrom(address, quantity, true);
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  // save address of target and clear buffer
+  txAddress = address;
+  txBuffer.clear();
+
+  transmissionBegun = true;
+}
+
+// Errors:
+//  0 : Success
+//  1 : Data too long
+//  2 : NACK on transmit of address
+//  3 : NACK on transmit of data
+//  4 : Other error
+//  5 : Timeout
+//  6 : Timeout, bus recovery failed
+uint8_t TwoWire::endTransmission(bool stopBit)
+{
+  transmissionBegun = false ;
+
+  if (!startTransfer(txAddress, txBuffer._aucBuffer, txBuffer.available(), NULL, 0, stopBit, NULL, NULL))
+  {
+    return 4;
+  }
+
+  return waitTransfer();
 }
 
 uint8_t TwoWire::endTransmission()
@@ -292,16 +604,13 @@ size_t TwoWire::write(uint8_t ucData)
 
 size_t TwoWire::write(const uint8_t *data, size_t quantity)
 {
-  //Try to store all data
-  for(size_t i = 0; i < quantity; ++i)
+  if ( !transmissionBegun )
   {
-    //Return the number of data stored, when the buffer is full (if write return 0)
-    if(!write(data[i]))
-      return i;
+    return 0 ;
   }
 
-  //All data stored
-  return quantity;
+  //Return the number of data stored, up to a full buffer
+  return txBuffer.store_chars( data, quantity ) ;
 }
 
 int TwoWire::available(void)
@@ -314,6 +623,11 @@ int TwoWire::read(void)
   return rxBuffer.read_char();
 }
 
+int TwoWire::read(uint8_t * buffer, size_t length)
+{
+  return rxBuffer.read_chars(buffer, length);
+}
+
 int TwoWire::peek(void)
 {
   return rxBuffer.peek();
@@ -335,8 +649,234 @@ void TwoWire::onRequest(void(*function)(void))
   onRequestCallback = function;
 }
 
+bool TwoWire::setRegisters(uint8_t address, const uint8_t * data, size_t length)
+{
+  uint8_t index;
+
+  if (address && address == _p_twis->ADDRESS[0])
+  {
+    index = 0;
+  }
+  else if (address && address == _p_twis->ADDRESS[1])
+  {
+    index = 1;
+  }
+  else
+  {
+    return false;
+  }
+
+  if (!isRamBuffer(data, length) || length > WIRE_MAX_REGISTERS)
+  {
+    return false;
+  }
+
+  // not while a read of the old region is being set up
+  NVIC_DisableIRQ(_IRQn);
+
+  registerData[index] = data;
+  registerLength[index] = length;
+
+  NVIC_EnableIRQ(_IRQn);
+
+  return true;
+}
+
+void TwoWire::onRegisterWrite(void(*function)(uint8_t, uint8_t, const uint8_t *, size_t))
+{
+  onRegisterWriteCallback = function;
+}
+
+void TwoWire::finishRegisterWrite(void)
+{
+  receiving = false;
+
+  uint8_t * buffer = registerBank ? txBuffer._aucBuffer : rxBuffer._aucBuffer;
+  size_t amount = _p_twis->RXD.AMOUNT;
+
+  if (amount == 0)
+  {
+    return;
+  }
+
+  registerPointer[registerMatch] = buffer[0];
+
+  // register select only, as before a read
+  if (amount == 1)
+  {
+    return;
+  }
+
+  // the next write goes to the other half
+  registerBank ^= 1;
+
+  if (onRegisterWriteCallback)
+  {
+    onRegisterWriteCallback(_p_twis->ADDRESS[registerMatch], buffer[0], buffer + 1, amount - 1);
+  }
+}
+
+void TwoWire::onRegisterService(void)
+{
+  if (_p_twis->EVENTS_WRITE)
+  {
+    _p_twis->EVENTS_WRITE = 0x0UL;
+
+    receiving = true;
+    registerRead = false;
+    registerMatch = _p_twis->MATCH & TWIS_MATCH_MATCH_Msk;
+
+    // the ring buffers are not used in this mode, they make up the double buffer
+    _p_twis->RXD.PTR = (uint32_t)(registerBank ? txBuffer._aucBuffer : rxBuffer._aucBuffer);
+    _p_twis->RXD.MAXCNT = SERIAL_BUFFER_SIZE;
+
+    _p_twis->TASKS_PREPARERX = 0x1UL;
+  }
+
+  if (_p_twis->EVENTS_READ)
+  {
+    _p_twis->EVENTS_READ = 0x0UL;
+
+    // repeated start after the register select
+    if (receiving)
+    {
+      finishRegisterWrite();
+    }
+
+    uint8_t index = _p_twis->MATCH & TWIS_MATCH_MATCH_Msk;
+    uint8_t pointer = registerPointer[index];
+    size_t length = registerLength[index];
+
+    registerMatch = index;
+    registerRead = true;
+
+    // past the end the master gets ORC
+    _p_twis->TXD.PTR = (uint32_t)(registerData[index] + pointer);
+    length = pointer < length ? length - pointer : 0;
+
+    _p_twis->TXD.MAXCNT = length < WIRE_MAX_TRANSFER_SIZE ? length : WIRE_MAX_TRANSFER_SIZE;
+
+    _p_twis->TASKS_PREPARETX = 0x1UL;
+  }
+
+  if (_p_twis->EVENTS_STOPPED)
+  {
+    _p_twis->EVENTS_STOPPED = 0x0UL;
+
+    if (receiving)
+    {
+      finishRegisterWrite();
+    }
+    else if (registerRead)
+    {
+      registerRead = false;
+      registerPointer[registerMatch] += _p_twis->TXD.AMOUNT;
+    }
+  }
+
+  if (_p_twis->EVENTS_ERROR)
+  {
+    _p_twis->EVENTS_ERROR = 0x0UL;
+
+    uint32_t error = _p_twis->ERRORSRC;
+    _p_twis->ERRORSRC = error;
+
+    _p_twis->TASKS_STOP = 0x1UL;
+  }
+}
+
+void TwoWire::onMasterService(void)
+{
+  if (_p_twim->EVENTS_ERROR)
+  {
+    _p_twim->EVENTS_ERROR = 0x0UL;
+
+    uint32_t error = _p_twim->ERRORSRC;
+
+    _p_twim->ERRORSRC = error;
+
+    if (error == TWIM_ERRORSRC_ANACK_Msk)
+    {
+      status = 2;
+    }
+    else if (error == TWIM_ERRORSRC_DNACK_Msk)
+    {
+      status = 3;
+    }
+    else
+    {
+      status = 4;
+    }
+
+    // always release the bus after an error
+    stopping = true;
+    _p_twim->SHORTS = 0;
+    _p_twim->TASKS_RESUME = 0x1UL;
+    _p_twim->TASKS_STOP = 0x1UL;
+  }
+
+  if (_p_twim->EVENTS_TXSTARTED)
+  {
+    _p_twim->EVENTS_TXSTARTED = 0x0UL;
+
+    // address only transfer
+    if (_p_twim->INTEN & TWIM_INTEN_TXSTARTED_Msk)
+    {
+      if (stopping)
+      {
+        _p_twim->TASKS_STOP = 0x1UL;
+      }
+      else
+      {
+        _p_twim->TASKS_SUSPEND = 0x1UL;
+      }
+    }
+  }
+
+  if (_p_twim->EVENTS_LASTRX && (_p_twim->INTEN & TWIM_INTEN_LASTRX_Msk))
+  {
+    _p_twim->EVENTS_LASTRX = 0x0UL;
+
+    if (!stopping)
+    {
+      _p_twim->TASKS_SUSPEND = 0x1UL;
+    }
+  }
+
+  bool done = false;
+
+  if (_p_twim->EVENTS_STOPPED)
+  {
+    _p_twim->EVENTS_STOPPED = 0x0UL;
+    done = true;
+  }
+
+  if (_p_twim->EVENTS_SUSPENDED)
+  {
+    _p_twim->EVENTS_SUSPENDED = 0x0UL;
+    done |= !stopping;
+  }
+
+  if (done && busy)
+  {
+    completeTransfer();
+  }
+}
+
 void TwoWire::onService(void)
 {
+  if (master)
+  {
+    onMasterService();
+    return;
+  }
+
+  if (registerMode)
+  {
+    onRegisterService();
+    return;
+  }
+
   if (_p_twis->EVENTS_WRITE)
   {
     _p_twis->EVENTS_WRITE = 0x0UL;
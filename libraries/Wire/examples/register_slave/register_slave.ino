@@ -0,0 +1,53 @@
+// Wire Register Slave
+//
+// Behaves like a typical I2C sensor on two addresses: the master writes a
+// register number, then reads from there on. Reads are served by the TWIS
+// from the arrays below without running any sketch code, writes to the
+// configuration registers arrive through onRegisterWrite().
+//
+// nRF52 only.
+
+#include <Wire.h>
+
+#define SENSOR_ADDRESS 0x40
+#define CONFIG_ADDRESS 0x41
+
+// 0: id, 1: status, 2-3: last sample (big endian)
+uint8_t sensorRegisters[4] = { 0x5a, 0x00, 0x00, 0x00 };
+uint8_t configRegisters[8];
+
+void setup()
+{
+  Wire.beginRegisters(SENSOR_ADDRESS, CONFIG_ADDRESS);
+  Wire.setRegisters(SENSOR_ADDRESS, sensorRegisters, sizeof(sensorRegisters));
+  Wire.setRegisters(CONFIG_ADDRESS, configRegisters, sizeof(configRegisters));
+  Wire.onRegisterWrite(registerWrite);
+}
+
+void loop()
+{
+  uint16_t sample = analogRead(A0);
+
+  // a read in progress may see one old and one new byte
+  noInterrupts();
+  sensorRegisters[2] = sample >> 8;
+  sensorRegisters[3] = sample;
+  sensorRegisters[1] = 0x01;
+  interrupts();
+
+  delay(10);
+}
+
+// called from the interrupt after the master wrote data bytes
+void registerWrite(uint8_t address, uint8_t reg, const uint8_t * data, size_t length)
+{
+  if (address != CONFIG_ADDRESS)
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < length && reg + i < sizeof(configRegisters); i++)
+  {
+    configRegisters[reg + i] = data[i];
+  }
+}
@@ -0,0 +1,67 @@
+// Wire Scheduled Sensors
+//
+// Demonstrates use of the WireScheduler to poll two I2C devices at
+// different rates without blocking loop().
+// Reads a register of device #4 every 10 ms and of device #5 every 100 ms.
+//
+// This example code is in the public domain.
+
+
+#include <Wire.h>
+#include <WireScheduler.h>
+
+WireScheduler scheduler(Wire);
+
+uint8_t fastRegister = 0x00;
+uint8_t fastValue[2];
+uint8_t slowRegister = 0x10;
+uint8_t slowValue[6];
+
+volatile uint32_t fastCount = 0;
+volatile uint32_t slowCount = 0;
+
+void fastDone(WireJob * job, uint8_t status)
+{
+  if (status == 0) fastCount++;
+}
+
+void slowDone(WireJob * job, uint8_t status)
+{
+  if (status == 0) slowCount++;
+}
+
+//               address  tx             txLength rx         rxLength period deadline priority callback
+WireJob fastJob = { 4, &fastRegister, 1, fastValue, sizeof(fastValue),  10, 2, 1, fastDone };
+WireJob slowJob = { 5, &slowRegister, 1, slowValue, sizeof(slowValue), 100, 0, 0, slowDone };
+
+void setup()
+{
+  Wire.begin();        // join i2c bus (address optional for master)
+  Serial.begin(9600);  // start serial for output
+
+  scheduler.begin();
+  scheduler.add(fastJob);
+  scheduler.add(slowJob);
+}
+
+void loop()
+{
+  scheduler.poll();
+
+  static unsigned long lastReport = 0;
+
+  if (millis() - lastReport >= 1000)
+  {
+    lastReport = millis();
+
+    Serial.print("fast: ");
+    Serial.print(fastCount);
+    Serial.print(" slow: ");
+    Serial.print(slowCount);
+    Serial.print(" bus: ");
+    Serial.print(scheduler.utilization());
+    Serial.println("%");
+
+    scheduler.resetStats();
+  }
+}
@@ -0,0 +1,362 @@
+// Format Benchmark
+//
+// CPU cycles per formatted number: ultoa() in bases 10, 16, 8 and 2, ltoa()
+// of negative numbers and print(value, base) into a Print that throws the
+// characters away. The values spread over all digit counts.
+//
+// Two base 10 variants kept in the sketch show which way of dividing by 100
+// the core should use on this chip: a per digit divide and modulo loop (the
+// old ultoa()) and the digit pair loop with 1/100 as a 64-bit reciprocal
+// multiply (what the core uses on the nRF52; the nRF51 divides instead, as
+// its Cortex-M0 has no 32x32->64 multiply).
+//
+// Doubles with 2 decimals go through fmtdouble() and print(), and through
+// what the core did before: dtostrf() on top of sprintf("%*.*f") and the
+// printFloat() loop printing one decimal at a time. Last, Print::printf()
+// against newlib's vsnprintf() into a stack buffer and write(), the way
+// printf() to a Print is usually done without it.
+//
+// For the code size, build once as is and once with WITH_SPRINTF set to 0
+// and compare the program size the IDE reports: the difference is what
+// newlib's vsnprintf() and float printf (which the old dtostrf() forced in)
+// cost. What fmtdouble() and Print::vprintf() themselves take,
+// arm-none-eabi-nm --size-sort -S on the .elf in the build folder lists.
+//
+// Cycles come from micros() over many calls, times F_CPU. Open the Serial
+// Monitor at 115200 baud.
+//
+// This example code is in the public domain.
+
+
+#define WITH_SPRINTF 1
+
+const int VALUES = 64;
+const int ROUNDS = 32;
+
+unsigned long values[VALUES];
+double doubles[VALUES];
+
+class NullPrint : public Print
+{
+  public:
+    size_t write(uint8_t) { return 1; }
+    size_t write(const uint8_t *, size_t size) { return size; }
+};
+
+NullPrint nullPrint;
+
+// keeps the compiler from dropping the conversions
+volatile char sink;
+
+char * divideLoop(unsigned long value, char * end)
+{
+  do {
+    *--end = '0' + value % 10;
+    value /= 10;
+  } while (value);
+
+  return end;
+}
+
+char * reciprocalPairs(unsigned long value, char * end)
+{
+  static const char pairs[] =
+    "00010203040506070809" "10111213141516171819" "20212223242526272829"
+    "30313233343536373839" "40414243444546474849" "50515253545556575859"
+    "60616263646566676869" "70717273747576777879" "80818283848586878889"
+    "90919293949596979899";
+
+  while (value >= 100) {
+    unsigned long q = (unsigned long)(((unsigned long long)value * 0x51EB851FUL) >> 37);
+    const char * pair = &pairs[(value - q * 100) * 2];
+
+    *--end = pair[1];
+    *--end = pair[0];
+    value = q;
+  }
+
+  if (value >= 10) {
+    *--end = pairs[value * 2 + 1];
+    *--end = pairs[value * 2];
+  } else {
+    *--end = '0' + value;
+  }
+
+  return end;
+}
+
+#if WITH_SPRINTF
+// the core's dtostrf() before fmtdouble()
+char * oldDtostrf(double val, signed char width, unsigned char prec, char * sout)
+{
+  asm(".global _printf_float");
+
+  char fmt[20];
+  sprintf(fmt, "%%%d.%df", width, prec);
+  sprintf(sout, fmt, val);
+  return sout;
+}
+#endif
+
+// the core's printFloat() before fmtdouble()
+size_t oldPrintFloat(Print & out, double number, uint8_t digits)
+{
+  size_t n = 0;
+
+  if (number < 0.0)
+  {
+     n += out.print('-');
+     number = -number;
+  }
+
+  double rounding = 0.5;
+  for (uint8_t i=0; i<digits; ++i)
+    rounding /= 10.0;
+
+  number += rounding;
+
+  unsigned long int_part = (unsigned long)number;
+  double remainder = number - (double)int_part;
+  n += out.print(int_part);
+
+  if (digits > 0) {
+    n += out.print(".");
+  }
+
+  while (digits-- > 0)
+  {
+    remainder *= 10.0;
+    int toPrint = int(remainder);
+    n += out.print(toPrint);
+    remainder -= toPrint;
+  }
+
+  return n;
+}
+
+#if WITH_SPRINTF
+size_t snprintfWrite(Print & out, const char * format, ...)
+{
+  char buffer[64];
+  va_list args;
+
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+
+  if (length < 0) {
+    return 0;
+  }
+
+  // cut off like the buffer
+  if (length >= (int)sizeof(buffer)) {
+    length = sizeof(buffer) - 1;
+  }
+
+  return out.write(buffer, length);
+}
+#endif
+
+void report(const char * name, unsigned long elapsedMicros)
+{
+  unsigned long calls = (unsigned long)VALUES * ROUNDS;
+  // F_CPU / 1000000 cycles per microsecond
+  unsigned long cycles = (elapsedMicros * (F_CPU / 1000000UL) + calls / 2) / calls;
+
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(cycles);
+  Serial.println(" cycles");
+}
+
+void benchmarkUltoa(const char * name, int base)
+{
+  char buffer[33];
+  unsigned long start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      ultoa(values[i], buffer, base);
+      sink = buffer[0];
+    }
+  }
+
+  report(name, micros() - start);
+}
+
+void benchmarkPrint(const char * name, int base)
+{
+  unsigned long start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      nullPrint.print(values[i], base);
+    }
+  }
+
+  report(name, micros() - start);
+}
+
+void benchmarkBase10(const char * name, char * (*convert)(unsigned long, char *))
+{
+  char buffer[11];
+  unsigned long start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      sink = *convert(values[i], &buffer[sizeof(buffer)]);
+    }
+  }
+
+  report(name, micros() - start);
+}
+
+void benchmarkFloats()
+{
+  char buffer[FMTDOUBLE_BUFFER_SIZE(2)];
+  unsigned long start;
+
+#if WITH_SPRINTF
+  start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      oldDtostrf(doubles[i], 0, 2, buffer);
+      sink = buffer[0];
+    }
+  }
+
+  report("sprintf dtostrf", micros() - start);
+#endif
+
+  start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      fmtdouble(doubles[i], 2, buffer);
+      sink = buffer[0];
+    }
+  }
+
+  report("fmtdouble", micros() - start);
+
+  start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      oldPrintFloat(nullPrint, doubles[i], 2);
+    }
+  }
+
+  report("old printFloat", micros() - start);
+
+  start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      nullPrint.print(doubles[i], 2);
+    }
+  }
+
+  report("print double", micros() - start);
+}
+
+void benchmarkPrintf()
+{
+  unsigned long start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      nullPrint.printf("%s %lu %08lx\r\n", "value", values[i], values[i]);
+    }
+  }
+
+  report("printf ints", micros() - start);
+
+  start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      nullPrint.printf("%.2f\r\n", doubles[i]);
+    }
+  }
+
+  report("printf float", micros() - start);
+
+#if WITH_SPRINTF
+  start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      snprintfWrite(nullPrint, "%s %lu %08lx\r\n", "value", values[i], values[i]);
+    }
+  }
+
+  report("vsnprintf ints", micros() - start);
+
+  start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      snprintfWrite(nullPrint, "%.2f\r\n", doubles[i]);
+    }
+  }
+
+  report("vsnprintf float", micros() - start);
+#endif
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  delay(1000);
+
+  uint32_t x = 2463534242UL;
+
+  for (int i = 0; i < VALUES; i++) {
+    // xorshift, shifted so every digit count shows up
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    values[i] = x >> (i % 32);
+    // up to 7 integer digits, within the range of the old printFloat()
+    doubles[i] = (double)(long)(values[i] >> 2) / ((i & 1) ? -1000.0 : 1000.0);
+  }
+
+  Serial.print("average of ");
+  Serial.print(VALUES * ROUNDS);
+  Serial.print(" numbers at ");
+  Serial.print(F_CPU / 1000000UL);
+  Serial.println(" MHz");
+
+  benchmarkUltoa("ultoa base 10", 10);
+  benchmarkUltoa("ultoa base 16", 16);
+  benchmarkUltoa("ultoa base 8", 8);
+  benchmarkUltoa("ultoa base 2", 2);
+
+  char buffer[34];
+  unsigned long start = micros();
+
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < VALUES; i++) {
+      ltoa(-(long)(values[i] >> 1), buffer, 10);
+      sink = buffer[0];
+    }
+  }
+
+  report("ltoa negative", micros() - start);
+
+  benchmarkPrint("print base 10", DEC);
+  benchmarkPrint("print base 16", HEX);
+
+  benchmarkBase10("divide loop", divideLoop);
+  benchmarkBase10("reciprocal pairs", reciprocalPairs);
+
+  benchmarkFloats();
+  benchmarkPrintf();
+}
+
+void loop()
+{
+}
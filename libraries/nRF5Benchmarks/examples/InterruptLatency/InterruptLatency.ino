@@ -0,0 +1,150 @@
+// Interrupt Latency
+//
+// CPU cycles from raising a GPIOTE event to the start of the
+// attachInterrupt() callback: the NVIC, the core's GPIOTE_IRQHandler and its
+// dispatch to the callback. The event is set from software on the channel
+// attachInterrupt() took for the pin, so nothing needs to be wired; the pin
+// is only pulled up so it doesn't float.
+//
+// On the nRF52 the cycles come from the DWT cycle counter, on the nRF51 (no
+// DWT) from TIMER2 running at 16 MHz, one tick per CPU cycle, captured before
+// the event and again in the callback. Each figure includes the couple of
+// cycles the two reads take.
+//
+// On the nRF51, upload it once per Tools > Interrupt Handlers setting and
+// compare: with handlers in RAM the minimum drops by the flash wait states
+// on the way. The nRF52 boards keep the handlers in flash, where the cache
+// serves them (RAM is fetched over the System bus there). The jitter
+// (max - min) shows how much the flash cache and other interrupts vary the
+// latency. Open the Serial Monitor at 115200 baud.
+//
+// This example code is in the public domain.
+
+
+const int PIN = 2;
+const int SAMPLES = 1000;
+
+volatile uint32_t entry;
+volatile bool entered;
+
+#if defined(NRF52_SERIES)
+
+void startCounter()
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t cycles()
+{
+  return DWT->CYCCNT;
+}
+
+#else
+
+void startCounter()
+{
+  NRF_TIMER2->MODE = TIMER_MODE_MODE_Timer;
+  NRF_TIMER2->BITMODE = TIMER_BITMODE_BITMODE_32Bit;
+  NRF_TIMER2->PRESCALER = 0;
+  NRF_TIMER2->TASKS_CLEAR = 1;
+  NRF_TIMER2->TASKS_START = 1;
+}
+
+static inline uint32_t cycles()
+{
+  NRF_TIMER2->TASKS_CAPTURE[0] = 1;
+  return NRF_TIMER2->CC[0];
+}
+
+#endif
+
+void onInterrupt()
+{
+  entry = cycles();
+  entered = true;
+}
+
+// the GPIOTE channel attachInterrupt() configured for the pin
+int channelOf(int pin)
+{
+  uint32_t psel = g_ADigitalPinMap[pin];
+
+  for (int ch = 0; ch < (int)(sizeof(NRF_GPIOTE->CONFIG) / sizeof(NRF_GPIOTE->CONFIG[0])); ch++) {
+    uint32_t config = NRF_GPIOTE->CONFIG[ch];
+
+    if ((config & GPIOTE_CONFIG_MODE_Msk) == (GPIOTE_CONFIG_MODE_Event << GPIOTE_CONFIG_MODE_Pos) &&
+        ((config & GPIOTE_CONFIG_PSEL_Msk) >> GPIOTE_CONFIG_PSEL_Pos) == psel) {
+      return ch;
+    }
+  }
+
+  return -1;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  delay(1000);
+
+  pinMode(PIN, INPUT_PULLUP);
+  attachInterrupt(PIN, onInterrupt, RISING);
+
+  int ch = channelOf(PIN);
+
+  if (ch < 0) {
+    Serial.println("no GPIOTE channel for the pin");
+    return;
+  }
+
+  startCounter();
+
+  uint32_t minimum = 0xFFFFFFFF;
+  uint32_t maximum = 0;
+  uint32_t total = 0;
+
+  for (int i = 0; i < SAMPLES; i++) {
+    entered = false;
+
+    uint32_t start = cycles();
+    NRF_GPIOTE->EVENTS_IN[ch] = 1;
+
+    while (!entered);
+
+    uint32_t latency = entry - start;
+
+    if (latency < minimum) minimum = latency;
+    if (latency > maximum) maximum = latency;
+    total += latency;
+
+    delayMicroseconds(50);
+  }
+
+  detachInterrupt(PIN);
+
+#if defined(CORE_ISR_IN_RAM) && !defined(NRF52_SERIES)
+  Serial.println("Interrupt Handlers: RAM");
+#else
+  Serial.println("Interrupt Handlers: Flash");
+#endif
+
+  Serial.print(SAMPLES);
+  Serial.print(" GPIOTE interrupts at ");
+  Serial.print(F_CPU / 1000000UL);
+  Serial.println(" MHz, cycles to the callback:");
+
+  Serial.print("min ");
+  Serial.print(minimum);
+  Serial.print(", avg ");
+  Serial.print((total + SAMPLES / 2) / SAMPLES);
+  Serial.print(", max ");
+  Serial.print(maximum);
+  Serial.print(", jitter ");
+  Serial.println(maximum - minimum);
+}
+
+void loop()
+{
+}
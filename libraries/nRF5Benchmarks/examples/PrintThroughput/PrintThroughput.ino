@@ -0,0 +1,171 @@
+// Print Throughput
+//
+// Times typical log lines written to Serial, reading micros() before and
+// after each call. "call" is how long the CPU is held by print(): the bytes
+// go into the TX buffer and the UART interrupt sends them, so a line that
+// fits returns long before it is on the wire. "sent" adds the flush() until
+// the last byte is out, which the baud rate bounds. The byte-by-byte row is
+// the per character path print() used before the bulk write() overrides.
+//
+// Also times filling the Wire transmit buffer in one write() and one byte
+// at a time. Nothing is sent on the bus.
+//
+// Results are printed after all runs, so printing them doesn't disturb the
+// measurement. Open the Serial Monitor at 115200 baud.
+//
+// This example code is in the public domain.
+
+
+#include <Wire.h>
+
+const int RUNS = 20;
+
+const char logLine[] = "I (12345) sensor: temp=23.50 hum=41.20 bat=3.71\n";
+
+struct Result
+{
+  const char * name;
+  unsigned long callMicros;
+  unsigned long sentMicros;
+  size_t bytes;
+};
+
+Result results[6];
+int resultCount = 0;
+
+unsigned long startMicros;
+unsigned long callMicros;
+
+void start()
+{
+  Serial.flush();
+  startMicros = micros();
+}
+
+void called()
+{
+  callMicros += micros() - startMicros;
+}
+
+void record(const char * name, unsigned long sentMicros, size_t bytes)
+{
+  results[resultCount].name = name;
+  results[resultCount].callMicros = callMicros / RUNS;
+  results[resultCount].sentMicros = sentMicros / RUNS;
+  results[resultCount].bytes = bytes;
+  resultCount++;
+  callMicros = 0;
+}
+
+unsigned long sent()
+{
+  Serial.flush();
+  return micros() - startMicros;
+}
+
+void benchmarkSerial()
+{
+  unsigned long total = 0;
+  size_t length = strlen(logLine);
+
+  for (int i = 0; i < RUNS; i++) {
+    start();
+    Serial.print(logLine);
+    called();
+    total += sent();
+  }
+  record("print(char *)", total, length);
+
+  total = 0;
+  for (int i = 0; i < RUNS; i++) {
+    start();
+    for (size_t n = 0; n < length; n++) {
+      Serial.write((uint8_t)logLine[n]);
+    }
+    called();
+    total += sent();
+  }
+  record("byte by byte", total, length);
+
+  String line(logLine);
+
+  total = 0;
+  for (int i = 0; i < RUNS; i++) {
+    start();
+    Serial.print(line);
+    called();
+    total += sent();
+  }
+  record("print(String)", total, line.length());
+
+  size_t bytes = 0;
+
+  total = 0;
+  for (int i = 0; i < RUNS; i++) {
+    start();
+    bytes = Serial.printf("I (%lu) sensor: temp=%d.%02d hum=%d.%02d\n", 12345UL, 23, 50, 41, 20);
+    called();
+    total += sent();
+  }
+  record("printf()", total, bytes);
+}
+
+void benchmarkWire()
+{
+  uint8_t data[32];
+
+  memset(data, 0x55, sizeof(data));
+
+  for (int i = 0; i < RUNS; i++) {
+    Wire.beginTransmission(0x42);
+    startMicros = micros();
+    Wire.write(data, sizeof(data));
+    called();
+  }
+  record("Wire.write(data, 32)", 0, sizeof(data));
+
+  for (int i = 0; i < RUNS; i++) {
+    Wire.beginTransmission(0x42);
+    startMicros = micros();
+    for (size_t n = 0; n < sizeof(data); n++) {
+      Wire.write(data[n]);
+    }
+    called();
+  }
+  record("Wire byte by byte", 0, sizeof(data));
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Wire.begin();
+
+  delay(1000);
+
+  benchmarkSerial();
+  benchmarkWire();
+
+  Serial.println();
+  Serial.print("average of ");
+  Serial.print(RUNS);
+  Serial.println(" runs, microseconds");
+
+  for (int i = 0; i < resultCount; i++) {
+    Serial.print(results[i].name);
+    Serial.print(": ");
+    Serial.print(results[i].bytes);
+    Serial.print(" bytes, call ");
+    Serial.print(results[i].callMicros);
+
+    if (results[i].sentMicros) {
+      Serial.print(", sent ");
+      Serial.print(results[i].sentMicros);
+    }
+
+    Serial.println();
+  }
+}
+
+void loop()
+{
+}